@@ -17,16 +17,42 @@
  * permissions and limitations under the License.
  */
 
+/* clock_gettime, fdopen, and syscall are not declared by strict c99 */
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define REF_SERVE_SOCKET
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
 
 #include "ref_adapt.h"
 #include "ref_args.h"
 #include "ref_axi.h"
 #include "ref_defs.h"
 #include "ref_dist.h"
+#include "ref_edge.h"
 #include "ref_egads.h"
 #include "ref_export.h"
 #include "ref_gather.h"
@@ -65,23 +91,36 @@ static void usage(const char *name) {
   printf("\n");
   printf("ref subcommands:\n");
   printf("  adapt        Adapt a mesh\n");
+  printf("  bench        Time the adaptation pipeline stages.\n");
   printf("  bootstrap    Create initial mesh from EGADS file\n");
   printf("  collar       Inflate surface to create swept mesh\n");
   printf("  distance     Calculate wall distance (for turbulence model)\n");
   printf("  examine      Report mesh or solution file meta data.\n");
+  printf("  fixture      Generate a benchmark box mesh and fields.\n");
   /*printf("  grow         Fills surface mesh with volume to debug
    * bootstrap\n");*/
   printf("  interpolate  Interpolate a field from one mesh to another\n");
   printf("  loop         Multiscale metric, adapt, and interpolation.\n");
   printf("  multiscale   Compute a multiscale metric.\n");
   /*printf("  node       Reports location of a node by index\n");*/
+  printf("  pipeline     Run a script of stages on an in-memory mesh.\n");
   /*printf("  quilt      Construct effective EGADS model.\n");*/
+  printf("  serve        Answer requests on a socket with a loaded mesh.\n");
   printf("  surface      depreciated, see translate ... --surface.\n");
   printf("  translate    Convert mesh formats.\n");
   printf("  visualize    Convert solution formats.\n");
   printf("  with2matrix  Intersection of matrices.\n");
   printf("\n");
   printf("'ref <command> -h' provides details on a specific subcommand.\n");
+  printf("'--threads <n>' sets threads per rank (OpenMP builds only).\n");
+  printf("'--stage-report <file.csv>' records each stopwatch stage time\n");
+  printf("    (min, max, mean over ranks) and memory high-water mark,\n");
+  printf("    grouped by scope (pipeline line, cycle, trial) and pass.\n");
+  printf("'--trace <file.json>' writes a trace_event timeline of each\n");
+  printf("    stopwatch stage and the wait within it for every rank.\n");
+  printf("'--perf-counters' reports cycles, instructions, cache and\n");
+  printf("    branch misses of each stage (Linux perf_event_open),\n");
+  printf("    of the main thread only in threaded builds.\n");
 }
 
 static void option_uniform_help(void) {
@@ -124,6 +163,12 @@ static void adapt_help(const char *name) {
   printf("      3: Zoltan graph partitioning.\n");
   printf("      4: Zoltan recursive bisection.\n");
   printf("      5: native recursive bisection.\n");
+  printf("  --pass-report <file.csv> per pass node counts and stage\n");
+  printf("      times (min, max, mean over ranks), adapt includes\n");
+  printf("      layer alignment.\n");
+  printf("  --conformity <fraction> reports the edge length histogram\n");
+  printf("      and stops when <fraction> of edges are in [0.707,1.414]\n");
+  printf("      and the fraction has stopped improving.\n");
   printf("\n");
 }
 static void collar_help(const char *name) {
@@ -142,6 +187,20 @@ static void collar_help(const char *name) {
   printf("  -x output_mesh.extension\n");
   printf("\n");
 }
+static void bench_help(const char *name) {
+  printf("usage: \n %s bench input_mesh.extension|nodes [<options>]\n", name);
+  printf("  times import (or part), wall distance, Hessian, metric,\n");
+  printf("  intersection, gradation, adapt pass, interp locate, and metric\n");
+  printf("  gather on the mesh or a generated fixture box of about nodes\n");
+  printf("  vertices. Wall distance is skipped without viscous tags.\n");
+  printf("  --trials <n> repeats (default 3) for mean and deviation.\n");
+  printf("  --complexity <c> target of the metric (default 1000).\n");
+  printf("  --save <file.json> writes the stage statistics.\n");
+  printf("  --baseline <file.json> compares to a --save result.\n");
+  printf("  --fun3d-mapbc fun3d_format.mapbc\n");
+  printf("  --viscous-tags <comma-separated list of viscous boundary tags>\n");
+  printf("\n");
+}
 static void bootstrap_help(const char *name) {
   printf("usage: \n %s bootstrap project.egads [-t]\n", name);
   printf("  -t  tecplot movie of surface curvature adaptation\n");
@@ -162,6 +221,16 @@ static void examine_help(const char *name) {
   printf("usage: \n %s examine input_mesh_or_solb.extension\n", name);
   printf("\n");
 }
+static void fixture_help(const char *name) {
+  printf("usage: \n %s fixture output_project nodes\n", name);
+  printf("  writes output_project.meshb of about nodes vertices,\n");
+  printf("  output_project.mapbc, and output_project_volume.solb\n");
+  printf("  of an analytic tanh shock and boundary layer on y=0.\n");
+  printf("  --channel 4x1x1 channel with wall spacing (default unit box).\n");
+  printf("  --series <timesteps> writes output_project_timestepN.solb\n");
+  printf("      density of a moving shock for --fixed-point _timestep.\n");
+  printf("\n");
+}
 static void grow_help(const char *name) {
   printf("usage: \n %s grow surface.meshb volume.meshb\n", name);
   printf("  --mesher {tetgen|aflr} volume mesher\n");
@@ -179,6 +248,13 @@ static void interpolate_help(const char *name) {
   printf("   --face <face id> <persist>.solb\n");
   printf("       where persist.solb is copied to receptor.solb\n");
   printf("       and face id is replaced with donor.solb.\n");
+  printf("   --save-weights <file> located donor nodes and weights.\n");
+  printf("   --load-weights <file> from --save-weights of the same\n");
+  printf("       donor and receptor meshes, skips point location.\n");
+  printf("       (weights are not available with --face).\n");
+  printf("   --series <first> <last> [<increment>] interpolates each\n");
+  printf("       donor.solb to receptor.solb with %%d (or %%0<width>d)\n");
+  printf("       replaced by the index, reusing grids and location.\n");
   printf("\n");
 }
 
@@ -238,7 +314,26 @@ static void loop_help(const char *name) {
       "incomp (incompressible vel magnitude),\n");
   printf("       htot, ptot, pressure, density, or temperature.\n");
   printf("       Read from file.solb, if not a recognized type.\n");
+  printf("       A comma-separated list (e.g., mach,temperature)\n");
+  printf("       intersects the multiscale metric of each interpolant.\n");
   printf("   --export-metric writes <input_project_name>-metric.solb.\n");
+  printf("   --no-error-report skips the interpolation error estimate.\n");
+  printf("   --lazy-field releases the solution during adaptation and\n");
+  printf("       rereads it for the final interpolation (less memory).\n");
+  printf("   --aux-storage <double|float|scratch> holds the solution on\n");
+  printf("       the background mesh during adaptation as double (default),\n");
+  printf("       float, or in a scratch file read back for interpolation.\n");
+  printf("       float and scratch are not combined with --lazy-field.\n");
+  printf("   --pass-report <file.csv> per pass node counts and stage\n");
+  printf("       times (min, max, mean over ranks), adapt includes\n");
+  printf("       layer alignment.\n");
+  printf("   --analytic-cycles <n> adapts n cycles to the Mach number of\n");
+  printf("       the fixture shock and boundary layer instead of reading\n");
+  printf("       a solution, then writes the analytic field\n");
+  printf("       (not with --pass-report or --conformity).\n");
+  printf("   --conformity <fraction> reports the edge length histogram\n");
+  printf("       and stops when <fraction> of edges are in [0.707,1.414]\n");
+  printf("       and the fraction has stopped improving.\n");
   printf("   --opt-goal metric of Loseille et al. AIAA 2007--4186.\n");
   printf("        Include flow and adjoint information in volume.solb.\n");
   printf("        Use --fun3d-mapbc or --viscous-tags with strong BCs.\n");
@@ -276,6 +371,7 @@ static void multiscale_help(const char *name) {
   printf("   --pcd <project.pcd> exports isotropic spacing point cloud.\n");
   printf("   --combine <scalar2.solb> <scalar2 ratio>.\n");
   printf("   --aspect-ratio <aspect ratio limit>.\n");
+  printf("   --no-error-report skips the interpolation error estimate.\n");
   printf("\n");
 }
 static void node_help(const char *name) {
@@ -283,12 +379,48 @@ static void node_help(const char *name) {
   printf("  node_index is zero-based\n");
   printf("\n");
 }
+static void pipeline_help(const char *name) {
+  printf("usage: \n %s pipeline script.txt\n", name);
+  printf("  runs one command per line, keeping the mesh, wall distance,\n");
+  printf("  field, and metrics in memory between commands ('#' comment).\n");
+  printf("   read <mesh.ext>             part or import the mesh\n");
+  printf("   egads <geometry.egads>      load geometry\n");
+  printf("   mapbc <fun3d.mapbc>         viscous walls from FUN3D bcs\n");
+  printf("   viscous-tags <tag,tag>      viscous walls from face ids\n");
+  printf("   distance                    wall distance\n");
+  printf("   field <field.solb>          read the field\n");
+  printf("   metric <metric.solb>        read the metric\n");
+  printf("   multiscale <complexity> [<index>] metric of field[index]\n");
+  printf("   save-metric                 keep a copy of the metric\n");
+  printf("   intersect                   metric with saved metric\n");
+  printf("   adapt [<passes>]            adapt, interpolate the field\n");
+  printf("   write-mesh <mesh.ext>\n");
+  printf("   write-field <field.solb>\n");
+  printf("   write-metric <metric.solb>\n");
+  printf("   write-distance <distance.solb>\n");
+  printf("\n");
+}
 static void quilt_help(const char *name) {
   printf("usage: \n %s quilt original.egads\n", name);
   printf("  originaleff.egads is output EGADS model with EBODY\n");
   option_auto_tprarms_help();
   printf("\n");
 }
+static void serve_help(const char *name) {
+  printf("usage: \n %s serve input_mesh.extension socket_path\n", name);
+  printf("  imports the mesh once and answers line requests on a Unix\n");
+  printf("  domain socket, each followed by ok or error <status>.\n");
+  printf("   stats                          node and cell counts\n");
+  printf("   node <global> ...              node locations\n");
+  printf("   field <field.solb>             load the field\n");
+  printf("   probe <x y z> ...              interpolate the field\n");
+  printf("   intersect <m0.solb> <m1.solb> <out.solb>\n");
+  printf("   slice <nx ny nz offset> <out.ext> slice the loaded field\n");
+  printf("   write <output.ext>             mesh, or field if loaded\n");
+  printf("   quit                           close this connection\n");
+  printf("   shutdown                       stop the server\n");
+  printf("\n");
+}
 static void translate_help(const char *name) {
   printf("usage: \n %s translate input_mesh.extension output_mesh.extension \n",
          name);
@@ -342,6 +474,327 @@ static void with2matrix_help(const char *name) {
   printf("\n");
 }
 
+static REF_DBL subcommand_wall_time(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (REF_DBL)now.tv_sec + 1.0e-9 * (REF_DBL)now.tv_nsec;
+}
+
+/* shared across ranks (unlike CLOCK_MONOTONIC) for trace timestamps */
+static REF_DBL subcommand_epoch_time(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+  return (REF_DBL)now.tv_sec + 1.0e-9 * (REF_DBL)now.tv_nsec;
+}
+
+/* optional record of every stopwatch stage, see --stage-report */
+static FILE *stage_report = NULL;
+static REF_BOOL stage_report_on = REF_FALSE;
+static const char *stage_subcommand = "";
+static REF_INT stage_sequence = 0;
+static REF_DBL stage_last_time = 0.0;
+static char stage_scope[64] = "";
+static REF_INT stage_pass = REF_EMPTY;
+
+/* optional trace_event timeline of every stage and rank, see --trace */
+static FILE *stage_trace = NULL;
+static REF_BOOL stage_trace_on = REF_FALSE;
+static REF_DBL stage_trace_epoch = 0.0;
+static REF_DBL stage_trace_begin = 0.0;
+static REF_DBL *stage_trace_times = NULL;
+
+/* optional hardware counters of every stage, see --perf-counters */
+#define REF_PERF_COUNTERS (4)
+static REF_BOOL stage_perf_on = REF_FALSE;
+static int stage_perf_fd[REF_PERF_COUNTERS] = {-1, -1, -1, -1};
+static REF_DBL stage_perf_last[REF_PERF_COUNTERS];
+/* counters follow the calling thread, not the OpenMP workers */
+static REF_BOOL stage_perf_main_thread = REF_FALSE;
+
+/* cycles, instructions, cache misses, branch misses of this process */
+static REF_STATUS stage_perf_read(REF_DBL *counts) {
+  REF_INT i;
+  for (i = 0; i < REF_PERF_COUNTERS; i++) counts[i] = 0.0;
+#ifdef __linux__
+  {
+    unsigned long long group[1 + REF_PERF_COUNTERS];
+    if (0 > stage_perf_fd[0]) return REF_SUCCESS;
+    RAS((ssize_t)sizeof(group) ==
+            read(stage_perf_fd[0], group, sizeof(group)),
+        "perf counter group read");
+    REIS(REF_PERF_COUNTERS, (REF_INT)group[0], "perf counter group size");
+    for (i = 0; i < REF_PERF_COUNTERS; i++) counts[i] = (REF_DBL)group[1 + i];
+  }
+#endif
+  return REF_SUCCESS;
+}
+
+static REF_STATUS stage_perf_close(void) {
+  REF_INT i;
+  for (i = REF_PERF_COUNTERS - 1; i >= 0; i--) {
+#ifdef __linux__
+    if (0 <= stage_perf_fd[i]) close(stage_perf_fd[i]);
+#endif
+    stage_perf_fd[i] = -1;
+  }
+  stage_perf_on = REF_FALSE;
+  return REF_SUCCESS;
+}
+
+/* collective, counters are enabled only if every rank can open them */
+static REF_STATUS stage_perf_open(REF_MPI ref_mpi) {
+  REF_INT available = 1, all_available;
+#ifdef __linux__
+  struct perf_event_attr attr;
+  unsigned long long config[REF_PERF_COUNTERS] = {
+      PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+  REF_INT i;
+  for (i = 0; i < REF_PERF_COUNTERS && available; i++) {
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config[i];
+    attr.disabled = (0 == i);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    stage_perf_fd[i] = (int)syscall(__NR_perf_event_open, &attr, 0, -1,
+                                    (0 == i) ? -1 : stage_perf_fd[0], 0);
+    if (0 > stage_perf_fd[i]) available = 0;
+  }
+#else
+  available = 0;
+#endif
+  RSS(ref_mpi_min(ref_mpi, &available, &all_available, REF_INT_TYPE), "min");
+  RSS(ref_mpi_bcast(ref_mpi, &all_available, 1, REF_INT_TYPE), "bcast");
+  if (!all_available) {
+    if (ref_mpi_once(ref_mpi))
+      printf("--perf-counters unavailable (perf_event_paranoid?)\n");
+    RSS(stage_perf_close(), "close");
+    return REF_SUCCESS;
+  }
+#ifdef __linux__
+  ioctl(stage_perf_fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(stage_perf_fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+  stage_perf_on = REF_TRUE;
+  stage_perf_main_thread = REF_FALSE;
+#ifdef _OPENMP
+  if (omp_get_max_threads() > 1) {
+    stage_perf_main_thread = REF_TRUE;
+    if (ref_mpi_once(ref_mpi))
+      printf("--perf-counters count the main thread of %d threads only\n",
+             omp_get_max_threads());
+  }
+#endif
+  RSS(stage_perf_read(stage_perf_last), "read");
+  return REF_SUCCESS;
+}
+
+/* collective, counts since the previous stage summed over ranks */
+static REF_STATUS stage_perf_stage(REF_MPI ref_mpi, REF_DBL *total) {
+  REF_DBL counts[REF_PERF_COUNTERS], delta[REF_PERF_COUNTERS];
+  REF_INT i;
+  RSS(stage_perf_read(counts), "read");
+  for (i = 0; i < REF_PERF_COUNTERS; i++) {
+    delta[i] = counts[i] - stage_perf_last[i];
+    stage_perf_last[i] = counts[i];
+  }
+  RSS(ref_mpi_sum(ref_mpi, delta, total, REF_PERF_COUNTERS, REF_DBL_TYPE),
+      "sum");
+  return REF_SUCCESS;
+}
+
+/* resident memory high-water mark in kB, -1 when unavailable */
+static REF_STATUS stage_memory_high_water(REF_LONG *kb) {
+  FILE *file;
+  char line[256];
+  long value;
+  *kb = -1;
+  file = fopen("/proc/self/status", "r");
+  if (NULL == (void *)file) return REF_SUCCESS;
+  while (NULL != fgets(line, 256, file)) {
+    if (1 == sscanf(line, "VmHWM: %ld kB", &value)) {
+      *kb = (REF_LONG)value;
+      break;
+    }
+  }
+  fclose(file);
+  return REF_SUCCESS;
+}
+
+static REF_STATUS stage_report_open(REF_MPI ref_mpi, const char *filename,
+                                    const char *subcommand) {
+  REF_INT opened = REF_TRUE;
+  stage_report_on = REF_TRUE;
+  stage_subcommand = subcommand;
+  stage_sequence = 0;
+  stage_last_time = subcommand_wall_time();
+  if (ref_mpi_once(ref_mpi)) {
+    stage_report = fopen(filename, "w");
+    if (NULL == (void *)stage_report) {
+      printf("unable to open %s\n", filename);
+      opened = REF_FALSE;
+    }
+  }
+  /* every rank fails together, the stage records are collective */
+  RSS(ref_mpi_bcast(ref_mpi, &opened, 1, REF_INT_TYPE), "bcast");
+  RAS(opened, "unable to open file");
+  if (!ref_mpi_once(ref_mpi)) return REF_SUCCESS;
+  fprintf(stage_report,
+          "subcommand,scope,pass,sequence,stage,ranks,seconds_min,"
+          "seconds_max,"
+          "seconds_mean,vmhwm_kb_min,vmhwm_kb_max");
+  if (stage_perf_on)
+    fprintf(stage_report,
+            ",cycles,instructions,cache_misses,branch_misses,ipc,"
+            "perf_threads");
+  fprintf(stage_report, "\n");
+  return REF_SUCCESS;
+}
+
+/* enclosing scope of the following stages, e.g. a pipeline line, an
+ * analytic cycle, or a bench trial, NULL clears */
+static REF_STATUS stage_scope_set(const char *scope) {
+  snprintf(stage_scope, 64, "%s", (NULL == scope) ? "" : scope);
+  return REF_SUCCESS;
+}
+
+/* adaptation pass of the following stages, REF_EMPTY clears */
+static REF_STATUS stage_pass_set(REF_INT pass) {
+  stage_pass = pass;
+  return REF_SUCCESS;
+}
+
+static REF_STATUS stage_report_close(void) {
+  if (NULL != stage_report) fclose(stage_report);
+  stage_report = NULL;
+  stage_report_on = REF_FALSE;
+  return REF_SUCCESS;
+}
+
+static REF_STATUS stage_trace_open(REF_MPI ref_mpi, const char *filename) {
+  REF_INT opened = REF_TRUE;
+  stage_trace_on = REF_TRUE;
+  stage_trace_epoch = subcommand_epoch_time();
+  RSS(ref_mpi_bcast(ref_mpi, &stage_trace_epoch, 1, REF_DBL_TYPE), "epoch");
+  if (ref_mpi_once(ref_mpi)) {
+    stage_trace = fopen(filename, "w");
+    if (NULL == (void *)stage_trace) {
+      printf("unable to open %s\n", filename);
+      opened = REF_FALSE;
+    }
+  }
+  /* every rank fails together, the trace gathers are collective */
+  RSS(ref_mpi_bcast(ref_mpi, &opened, 1, REF_INT_TYPE), "bcast");
+  RAS(opened, "unable to open file");
+  stage_trace_begin = subcommand_epoch_time();
+  if (!ref_mpi_once(ref_mpi)) return REF_SUCCESS;
+  ref_malloc(stage_trace_times, 3 * ref_mpi_n(ref_mpi), REF_DBL);
+  /* JSON array format, the closing bracket is optional for viewers */
+  fprintf(stage_trace, "[\n");
+  return REF_SUCCESS;
+}
+
+static REF_STATUS stage_trace_close(void) {
+  if (NULL != stage_trace) {
+    fprintf(stage_trace, "{}]\n");
+    fclose(stage_trace);
+  }
+  stage_trace = NULL;
+  ref_free(stage_trace_times);
+  stage_trace_times = NULL;
+  stage_trace_on = REF_FALSE;
+  return REF_SUCCESS;
+}
+
+/* collective, rank 0 writes the work and wait span of each rank */
+static REF_STATUS stage_trace_write(REF_MPI ref_mpi, const char *stage,
+                                    REF_DBL arrive) {
+  REF_DBL leave = subcommand_epoch_time();
+  REF_DBL *times = stage_trace_times;
+  REF_INT rank, n = ref_mpi_n(ref_mpi);
+  RSS(ref_mpi_gather(ref_mpi, &stage_trace_begin, times, REF_DBL_TYPE),
+      "gather begin");
+  RSS(ref_mpi_gather(ref_mpi, &arrive, (NULL == times ? NULL : &(times[n])),
+                     REF_DBL_TYPE),
+      "gather arrive");
+  RSS(ref_mpi_gather(ref_mpi, &leave,
+                     (NULL == times ? NULL : &(times[2 * n])), REF_DBL_TYPE),
+      "gather leave");
+  if (ref_mpi_once(ref_mpi) && NULL != stage_trace) {
+    for (rank = 0; rank < n; rank++) {
+      fprintf(stage_trace,
+              "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":0,"
+              "\"tid\":%d,\"ts\":%.1f,\"dur\":%.1f},\n",
+              stage, stage_subcommand, rank,
+              1.0e6 * (times[rank] - stage_trace_epoch),
+              1.0e6 * (times[n + rank] - times[rank]));
+      fprintf(stage_trace,
+              "{\"name\":\"wait\",\"cat\":\"stopwatch\",\"ph\":\"X\","
+              "\"pid\":0,\"tid\":%d,\"ts\":%.1f,\"dur\":%.1f},\n",
+              rank, 1.0e6 * (times[n + rank] - stage_trace_epoch),
+              1.0e6 * (times[2 * n + rank] - times[n + rank]));
+    }
+    fflush(stage_trace);
+  }
+  stage_trace_begin = subcommand_epoch_time();
+  return REF_SUCCESS;
+}
+
+static REF_STATUS stage_stopwatch_start(REF_MPI ref_mpi) {
+  ref_mpi_stopwatch_start(ref_mpi);
+  stage_last_time = subcommand_wall_time();
+  stage_trace_begin = subcommand_epoch_time();
+  return REF_SUCCESS;
+}
+
+/* ref_mpi_stopwatch_stop, plus collective stage records when enabled */
+static REF_STATUS stage_stopwatch_stop(REF_MPI ref_mpi, const char *stage) {
+  REF_DBL seconds, seconds_min, seconds_max, seconds_sum;
+  REF_LONG kb, kb_min, kb_max;
+  REF_DBL arrive = 0.0;
+  REF_DBL perf[REF_PERF_COUNTERS] = {0.0, 0.0, 0.0, 0.0};
+  if (stage_trace_on) arrive = subcommand_epoch_time();
+  if (stage_perf_on) {
+    RSS(stage_perf_stage(ref_mpi, perf), "perf");
+  }
+  ref_mpi_stopwatch_stop(ref_mpi, stage);
+  if (stage_perf_on && ref_mpi_once(ref_mpi) && perf[0] > 0.0 &&
+      perf[1] > 0.0)
+    printf(" perf %s: %.3e instructions, %.2f IPC, %.2f cache and %.2f "
+           "branch misses per 1000 instructions\n",
+           stage, perf[1], perf[1] / perf[0], 1000.0 * perf[2] / perf[1],
+           1000.0 * perf[3] / perf[1]);
+  if (stage_trace_on) RSS(stage_trace_write(ref_mpi, stage, arrive), "trace");
+  if (!stage_report_on) return REF_SUCCESS;
+  seconds = subcommand_wall_time() - stage_last_time;
+  RSS(stage_memory_high_water(&kb), "VmHWM");
+  RSS(ref_mpi_min(ref_mpi, &seconds, &seconds_min, REF_DBL_TYPE), "min");
+  RSS(ref_mpi_max(ref_mpi, &seconds, &seconds_max, REF_DBL_TYPE), "max");
+  RSS(ref_mpi_sum(ref_mpi, &seconds, &seconds_sum, 1, REF_DBL_TYPE), "sum");
+  RSS(ref_mpi_min(ref_mpi, &kb, &kb_min, REF_LONG_TYPE), "min");
+  RSS(ref_mpi_max(ref_mpi, &kb, &kb_max, REF_LONG_TYPE), "max");
+  if (ref_mpi_once(ref_mpi) && NULL != stage_report) {
+    fprintf(stage_report, "%s,\"%s\",", stage_subcommand, stage_scope);
+    if (REF_EMPTY != stage_pass) fprintf(stage_report, "%d", stage_pass + 1);
+    fprintf(stage_report, ",%d,\"%s\",%d,%.6f,%.6f,%.6f,%ld,%ld",
+            stage_sequence, stage, ref_mpi_n(ref_mpi), seconds_min, seconds_max,
+            seconds_sum / (REF_DBL)ref_mpi_n(ref_mpi), (long)kb_min,
+            (long)kb_max);
+    if (stage_perf_on)
+      fprintf(stage_report, ",%.0f,%.0f,%.0f,%.0f,%.4f,%s", perf[0], perf[1],
+              perf[2], perf[3], (perf[0] > 0.0 ? perf[1] / perf[0] : 0.0),
+              (stage_perf_main_thread ? "main" : "all"));
+    fprintf(stage_report, "\n");
+    fflush(stage_report);
+  }
+  stage_sequence++;
+  stage_last_time = subcommand_wall_time();
+  return REF_SUCCESS;
+}
+
 static REF_STATUS with2matrix(REF_MPI ref_mpi, int argc, char *argv[]) {
     
     REF_INT intersection_pos = 1;
@@ -420,7 +873,7 @@ static REF_STATUS spalding_metric(REF_GRID ref_grid, REF_DICT ref_dict_bcs,
   ref_malloc(distance, ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
   ref_malloc(uplus, ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
   RSS(ref_phys_wall_distance(ref_grid, ref_dict_bcs, distance), "wall dist");
-  ref_mpi_stopwatch_stop(ref_mpi, "wall distance");
+  RSS(stage_stopwatch_stop(ref_mpi, "wall distance"), "stopwatch");
 
   FILE *fp;
   if (mehul_iter==0){
@@ -476,11 +929,11 @@ static REF_STATUS spalding_metric(REF_GRID ref_grid, REF_DICT ref_dict_bcs,
   ref_free(uplus);
   ref_free(distance);
   ref_free(metric);
-  ref_mpi_stopwatch_stop(ref_mpi, "spalding gradation");
+  RSS(stage_stopwatch_stop(ref_mpi, "spalding gradation"), "stopwatch");
   if (ref_geom_model_loaded(ref_grid_geom(ref_grid)) ||
       ref_geom_meshlinked(ref_grid_geom(ref_grid))) {
     RSS(ref_metric_constrain_curvature(ref_grid), "crv const");
-    ref_mpi_stopwatch_stop(ref_mpi, "crv const");
+    RSS(stage_stopwatch_stop(ref_mpi, "crv const"), "stopwatch");
   }
 
   out_metric = "spalding-output-metric.solb";
@@ -608,7 +1061,7 @@ static REF_STATUS distance_metric_fill(REF_GRID ref_grid, REF_DICT ref_dict_bcs,
 
   ref_malloc(distance, ref_node_max(ref_node), REF_DBL);
   RSS(ref_phys_wall_distance(ref_grid, ref_dict_bcs, distance), "wall dist");
-  ref_mpi_stopwatch_stop(ref_mpi, "wall distance");
+  RSS(stage_stopwatch_stop(ref_mpi, "wall distance"), "stopwatch");
 
   ref_malloc(grad_dist, 3 * ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
   RSS(ref_recon_gradient(ref_grid, distance, grad_dist, recon), "grad dist");
@@ -717,6 +1170,141 @@ static REF_STATUS distance_metric_fill(REF_GRID ref_grid, REF_DICT ref_dict_bcs,
   return REF_SUCCESS;
 }
 
+#define REF_PASS_REPORT_STAGES (3)
+
+/* adapt or loop holds at most one pass report, file scope so a failed
+ * pass can close it */
+static FILE *pass_report = NULL;
+
+static REF_STATUS pass_report_close(void) {
+  if (NULL != pass_report) fclose(pass_report);
+  pass_report = NULL;
+  return REF_SUCCESS;
+}
+
+static REF_STATUS pass_report_open(REF_MPI ref_mpi, const char *filename) {
+  const char *stages[REF_PASS_REPORT_STAGES] = {"adapt", "metric",
+                                                "balance"};
+  REF_INT stage, opened = REF_TRUE;
+  RSS(pass_report_close(), "close previous");
+  if (ref_mpi_once(ref_mpi)) {
+    pass_report = fopen(filename, "w");
+    if (NULL == (void *)pass_report) {
+      printf("unable to open %s\n", filename);
+      opened = REF_FALSE;
+    }
+  }
+  /* every rank fails together before the collective pass loop */
+  RSS(ref_mpi_bcast(ref_mpi, &opened, 1, REF_INT_TYPE), "bcast");
+  RAS(opened, "unable to open file");
+  if (!ref_mpi_once(ref_mpi)) return REF_SUCCESS;
+  fprintf(pass_report, "pass,ranks,nodes,owned_min,owned_max");
+  for (stage = 0; stage < REF_PASS_REPORT_STAGES; stage++)
+    fprintf(pass_report, ",%s_min,%s_max,%s_mean", stages[stage],
+            stages[stage], stages[stage]);
+  fprintf(pass_report, "\n");
+  return REF_SUCCESS;
+}
+
+/* collective, every rank contributes its owned nodes and stage times */
+static REF_STATUS pass_report_write(REF_GRID ref_grid, REF_INT pass,
+                                    REF_DBL *seconds) {
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_INT node, owned = 0, owned_min, owned_max, stage;
+  REF_DBL time_min, time_max, time_sum;
+  each_ref_node_valid_node(ref_node, node) {
+    if (ref_node_owned(ref_node, node)) owned++;
+  }
+  RSS(ref_mpi_min(ref_mpi, &owned, &owned_min, REF_INT_TYPE), "mpi min");
+  RSS(ref_mpi_max(ref_mpi, &owned, &owned_max, REF_INT_TYPE), "mpi max");
+  if (ref_mpi_once(ref_mpi))
+    fprintf(pass_report, "%d,%d," REF_GLOB_FMT ",%d,%d", pass + 1,
+            ref_mpi_n(ref_mpi), ref_node_n_global(ref_node), owned_min,
+            owned_max);
+  for (stage = 0; stage < REF_PASS_REPORT_STAGES; stage++) {
+    RSS(ref_mpi_min(ref_mpi, &(seconds[stage]), &time_min, REF_DBL_TYPE),
+        "mpi min");
+    RSS(ref_mpi_max(ref_mpi, &(seconds[stage]), &time_max, REF_DBL_TYPE),
+        "mpi max");
+    RSS(ref_mpi_sum(ref_mpi, &(seconds[stage]), &time_sum, 1, REF_DBL_TYPE),
+        "mpi sum");
+    if (ref_mpi_once(ref_mpi))
+      fprintf(pass_report, ",%.6f,%.6f,%.6f", time_min, time_max,
+              time_sum / (REF_DBL)ref_mpi_n(ref_mpi));
+  }
+  if (ref_mpi_once(ref_mpi)) {
+    fprintf(pass_report, "\n");
+    fflush(pass_report);
+  }
+  return REF_SUCCESS;
+}
+
+#define REF_CONFORMITY_BINS (10)
+
+/* histogram of metric edge length in half powers of two, returns the
+ * global fraction of edges within [1/sqrt(2),sqrt(2)] */
+static REF_STATUS edge_conformity(REF_GRID ref_grid, REF_DBL *fraction) {
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_EDGE ref_edge;
+  REF_LONG count[REF_CONFORMITY_BINS];
+  REF_LONG total;
+  REF_INT edge, n0, n1, bin;
+  REF_DBL ratio;
+  for (bin = 0; bin < REF_CONFORMITY_BINS; bin++) count[bin] = 0;
+  RSS(ref_edge_create(&ref_edge, ref_grid), "edges");
+  for (edge = 0; edge < ref_edge_n(ref_edge); edge++) {
+    n0 = ref_edge_e2n(ref_edge, 0, edge);
+    n1 = ref_edge_e2n(ref_edge, 1, edge);
+    /* counted by the part owning the lower global index */
+    if (ref_node_global(ref_node, n1) < ref_node_global(ref_node, n0)) {
+      REF_INT temp = n0;
+      n0 = n1;
+      n1 = temp;
+    }
+    if (!ref_node_owned(ref_node, n0)) continue;
+    RSS(ref_node_ratio(ref_node, n0, n1, &ratio), "ratio");
+    bin = REF_CONFORMITY_BINS - 1;
+    if (ratio > 0.0)
+      bin = (REF_INT)floor(2.0 * log2(ratio)) + REF_CONFORMITY_BINS / 2;
+    bin = MAX(0, MIN(REF_CONFORMITY_BINS - 1, bin));
+    count[bin]++;
+  }
+  RSS(ref_edge_free(ref_edge), "free edges");
+  RSS(ref_mpi_allsum(ref_mpi, count, REF_CONFORMITY_BINS, REF_LONG_TYPE),
+      "allsum");
+  total = 0;
+  for (bin = 0; bin < REF_CONFORMITY_BINS; bin++) total += count[bin];
+  *fraction = 0.0;
+  if (total > 0)
+    *fraction = (REF_DBL)(count[REF_CONFORMITY_BINS / 2 - 1] +
+                          count[REF_CONFORMITY_BINS / 2]) /
+                (REF_DBL)total;
+  if (ref_mpi_once(ref_mpi)) {
+    printf("edge length histogram (%ld edges)\n", (long)total);
+    for (bin = 0; bin < REF_CONFORMITY_BINS; bin++) {
+      printf(" %s%7.3f %10ld\n", (0 == bin) ? "<" : " ",
+             pow(2.0, 0.5 * (REF_DBL)(MAX(1, bin) - REF_CONFORMITY_BINS / 2)),
+             (long)count[bin]);
+    }
+    printf("%.4f of edges in [1/sqrt(2),sqrt(2)]\n", *fraction);
+  }
+  return REF_SUCCESS;
+}
+
+/* converged when enough edges conform and the fraction has stalled */
+static REF_STATUS conformity_done(REF_GRID ref_grid, REF_DBL target,
+                                  REF_DBL *previous, REF_BOOL *done) {
+  REF_DBL fraction;
+  RSS(edge_conformity(ref_grid, &fraction), "conformity");
+  *done = (fraction >= target && fraction - *previous < 0.005);
+  *previous = fraction;
+  if (*done && ref_mpi_once(ref_grid_mpi(ref_grid)))
+    printf("edge conformity %.4f reached target %.4f\n", fraction, target);
+  return REF_SUCCESS;
+}
+
 static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
   char *in_mesh = NULL;
   char *in_metric = NULL;
@@ -737,6 +1325,10 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
   REF_DICT ref_dict_bcs = NULL;
   REF_DBL spalding_yplus = -1.0;
   REF_DBL complexity = -1.0;
+  REF_BOOL report_passes = REF_FALSE;
+  REF_DBL pass_seconds[REF_PASS_REPORT_STAGES], pass_time;
+  REF_DBL conformity = -1.0, last_conformity = 0.0;
+  REF_BOOL conformed = REF_FALSE;
 
   if (argc < 3) goto shutdown;
   in_mesh = argv[2];
@@ -745,12 +1337,12 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
     if (ref_mpi_once(ref_mpi)) printf("part %s\n", in_mesh);
     RSS(ref_part_by_extension(&ref_grid, ref_mpi, in_mesh), "part");
     ref_mpi = ref_grid_mpi(ref_grid); /* ref_grid made a deep copy */
-    ref_mpi_stopwatch_stop(ref_mpi, "part");
+    RSS(stage_stopwatch_stop(ref_mpi, "part"), "stopwatch");
   } else {
     if (ref_mpi_once(ref_mpi)) printf("import %s\n", in_mesh);
     RSS(ref_import_by_extension(&ref_grid, ref_mpi, in_mesh), "import");
     ref_mpi = ref_grid_mpi(ref_grid); /* ref_grid made a deep copy */
-    ref_mpi_stopwatch_stop(ref_mpi, "import");
+    RSS(stage_stopwatch_stop(ref_mpi, "import"), "stopwatch");
   }
   if (ref_mpi_once(ref_mpi))
     printf("  read " REF_GLOB_FMT " vertices\n",
@@ -770,7 +1362,7 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
       RSS(ref_egads_load(ref_grid_geom(ref_grid), in_egads), "load egads");
       if (ref_mpi_once(ref_mpi) && ref_geom_effective(ref_grid_geom(ref_grid)))
         printf("EBody Effective Body loaded\n");
-      ref_mpi_stopwatch_stop(ref_mpi, "load egads");
+      RSS(stage_stopwatch_stop(ref_mpi, "load egads"), "stopwatch");
     } else {
       if (0 < ref_geom_cad_data_size(ref_grid_geom(ref_grid))) {
         if (ref_mpi_once(ref_mpi))
@@ -779,7 +1371,7 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
         if (ref_mpi_once(ref_mpi) &&
             ref_geom_effective(ref_grid_geom(ref_grid)))
           printf("EBody Effective Body loaded\n");
-        ref_mpi_stopwatch_stop(ref_mpi, "load egads");
+        RSS(stage_stopwatch_stop(ref_mpi, "load egads"), "stopwatch");
       } else {
         if (ref_mpi_once(ref_mpi)) {
           printf("warning: no geometry loaded, assuming planar faces.\n");
@@ -799,7 +1391,7 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
       ref_geom_meshlinked(ref_grid_geom(ref_grid))) {
     RSS(ref_geom_verify_topo(ref_grid), "geom topo");
     RSS(ref_geom_verify_param(ref_grid), "geom param");
-    ref_mpi_stopwatch_stop(ref_mpi, "geom assoc");
+    RSS(stage_stopwatch_stop(ref_mpi, "geom assoc"), "stopwatch");
   }
 
   RXS(ref_args_find(argc, argv, "--facelift", &pos), REF_NOT_FOUND,
@@ -807,7 +1399,7 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
   if (REF_EMPTY != pos && pos < argc - 1) {
     if (ref_mpi_once(ref_mpi)) printf("--facelift %s import\n", argv[pos + 1]);
     RSS(ref_facelift_import(ref_grid, argv[pos + 1]), "attach");
-    ref_mpi_stopwatch_stop(ref_mpi, "facelift loaded");
+    RSS(stage_stopwatch_stop(ref_mpi, "facelift loaded"), "stopwatch");
   }
 
   RXS(ref_args_find(argc, argv, "--surrogate", &pos), REF_NOT_FOUND,
@@ -815,13 +1407,13 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
   if (REF_EMPTY != pos && pos < argc - 1) {
     if (ref_mpi_once(ref_mpi)) printf("--surrogate %s import\n", argv[pos + 1]);
     RSS(ref_facelift_surrogate(ref_grid, argv[pos + 1]), "attach");
-    ref_mpi_stopwatch_stop(ref_mpi, "facelift loaded");
+    RSS(stage_stopwatch_stop(ref_mpi, "facelift loaded"), "stopwatch");
     if (ref_mpi_once(ref_mpi)) printf("constrain all\n");
     RSS(ref_geom_constrain_all(ref_grid), "constrain");
-    ref_mpi_stopwatch_stop(ref_mpi, "constrain param");
+    RSS(stage_stopwatch_stop(ref_mpi, "constrain param"), "stopwatch");
     if (ref_mpi_once(ref_mpi)) printf("verify constrained param\n");
     RSS(ref_geom_verify_param(ref_grid), "constrained params");
-    ref_mpi_stopwatch_stop(ref_mpi, "verify param");
+    RSS(stage_stopwatch_stop(ref_mpi, "verify param"), "stopwatch");
   }
 
   RXS(ref_args_find(argc, argv, "-t", &pos), REF_NOT_FOUND, "arg search");
@@ -890,7 +1482,7 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
     if (ref_mpi_once(ref_mpi)) printf("part metric %s\n", in_metric);
     RSS(ref_part_metric(ref_grid_node(ref_grid), in_metric), "part metric");
     curvature_metric = REF_FALSE;
-    ref_mpi_stopwatch_stop(ref_mpi, "part metric");
+    RSS(stage_stopwatch_stop(ref_mpi, "part metric"), "stopwatch");
   }
 
   RSS(ref_dict_create(&ref_dict_bcs), "make dict");
@@ -994,7 +1586,7 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
     RAS(complexity > 1.0e-20, "complexity must be greater than zero");
     ref_malloc(metric, 6 * ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
     RSS(ref_metric_imply_from(metric, ref_grid), "imply metric");
-    ref_mpi_stopwatch_stop(ref_mpi, "imply metric");
+    RSS(stage_stopwatch_stop(ref_mpi, "imply metric"), "stopwatch");
     RSS(ref_metric_set_complexity(metric, ref_grid, complexity),
         "scale metric");
     RSS(ref_metric_parse(metric, ref_grid, argc, argv), "parse metric");
@@ -1014,7 +1606,7 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
             "spalding");
       } else {
         RSS(ref_metric_interpolated_curvature(ref_grid), "interp curve");
-        ref_mpi_stopwatch_stop(ref_mpi, "curvature metric");
+        RSS(stage_stopwatch_stop(ref_mpi, "curvature metric"), "stopwatch");
         RXS(ref_args_find(argc, argv, "--facelift-metric", &pos), REF_NOT_FOUND,
             "arg search");
         if (REF_EMPTY != pos && pos < argc - 1) {
@@ -1023,7 +1615,7 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
             printf("--facelift-metric %f\n", complexity);
           RAS(complexity > 1.0e-20, "complexity must be greater than zero");
           RSS(ref_facelift_multiscale(ref_grid, complexity), "metric");
-          ref_mpi_stopwatch_stop(ref_mpi, "facelift metric");
+          RSS(stage_stopwatch_stop(ref_mpi, "facelift metric"), "stopwatch");
         }
       }
     }
@@ -1037,7 +1629,7 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
         ref_geom_meshlinked(ref_grid_geom(ref_grid))) {
       RSS(ref_metric_constrain_curvature(ref_grid), "crv const");
       RSS(ref_validation_cell_volume(ref_grid), "vol");
-      ref_mpi_stopwatch_stop(ref_mpi, "crv const");
+      RSS(stage_stopwatch_stop(ref_mpi, "crv const"), "stopwatch");
     }
     RXS(ref_args_find(argc, argv, "--uniform", &pos), REF_NOT_FOUND,
         "arg search");
@@ -1045,25 +1637,44 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
       RSS(ref_metric_parse_to_node(ref_grid, argc, argv), "parse uniform");
     }
     RSS(ref_grid_cache_background(ref_grid), "cache");
-    ref_mpi_stopwatch_stop(ref_mpi, "cache background metric");
+    RSS(stage_stopwatch_stop(ref_mpi, "cache background metric"), "stopwatch");
   }
 
   RSS(ref_validation_cell_volume(ref_grid), "vol");
 
   RSS(ref_migrate_to_balance(ref_grid), "balance");
   RSS(ref_grid_pack(ref_grid), "pack");
-  ref_mpi_stopwatch_stop(ref_mpi, "pack");
+  RSS(stage_stopwatch_stop(ref_mpi, "pack"), "stopwatch");
+
+  RXS(ref_args_find(argc, argv, "--pass-report", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos && pos < argc - 1) {
+    if (ref_mpi_once(ref_mpi)) printf("--pass-report %s\n", argv[pos + 1]);
+    RSS(pass_report_open(ref_mpi, argv[pos + 1]), "open");
+    report_passes = REF_TRUE;
+  }
+
+  RXS(ref_args_find(argc, argv, "--conformity", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos && pos < argc - 1) {
+    conformity = atof(argv[pos + 1]);
+    if (ref_mpi_once(ref_mpi)) printf("--conformity %f\n", conformity);
+  }
 
   for (pass = 0; !all_done && pass < passes; pass++) {
+    RSS(stage_pass_set(pass), "scope");
     if (ref_mpi_once(ref_mpi))
       printf("\n pass %d of %d with %d ranks\n", pass + 1, passes,
              ref_mpi_n(ref_mpi));
+    pass_time = subcommand_wall_time();
     if (form_quads && pass == passes - 5)
       RSS(ref_layer_align_quad(ref_grid), "quad");
     if (form_prism && pass == passes / 2)
       RSS(ref_layer_align_prism(ref_grid, ref_dict_bcs), "prism");
     all_done1 = all_done0;
     RSS(ref_adapt_pass(ref_grid, &all_done0), "pass");
+    pass_seconds[0] = subcommand_wall_time() - pass_time;
+    pass_time = subcommand_wall_time();
     all_done = all_done0 && all_done1 && (pass > MIN(5, passes)) && !form_quads;
     if (curvature_metric) {
       if (distance_metric) {
@@ -1077,7 +1688,7 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
               "spalding");*/
         } else {
           RSS(ref_metric_interpolated_curvature(ref_grid), "interp curve");
-          ref_mpi_stopwatch_stop(ref_mpi, "curvature metric");
+          RSS(stage_stopwatch_stop(ref_mpi, "curvature metric"), "stopwatch");
           RXS(ref_args_find(argc, argv, "--facelift-metric", &pos),
               REF_NOT_FOUND, "arg search");
           if (REF_EMPTY != pos && pos < argc - 1) {
@@ -1086,7 +1697,7 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
               printf("--facelift-metric %f\n", complexity);
             RAS(complexity > 1.0e-20, "complexity must be greater than zero");
             RSS(ref_facelift_multiscale(ref_grid, complexity), "metric");
-            ref_mpi_stopwatch_stop(ref_mpi, "facelift metric");
+            RSS(stage_stopwatch_stop(ref_mpi, "facelift metric"), "stopwatch");
           }
         }
       }
@@ -1097,15 +1708,32 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
       }
     } else {
       RSS(ref_metric_synchronize(ref_grid), "sync with background");
-      ref_mpi_stopwatch_stop(ref_mpi, "metric sync");
+      RSS(stage_stopwatch_stop(ref_mpi, "metric sync"), "stopwatch");
     }
+    pass_seconds[1] = subcommand_wall_time() - pass_time;
+    pass_time = subcommand_wall_time();
     RSS(ref_validation_cell_volume(ref_grid), "vol");
     RSS(ref_adapt_tattle_faces(ref_grid), "tattle");
-    ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "tattle faces");
+    RSS(stage_stopwatch_stop(ref_grid_mpi(ref_grid), "tattle faces"),
+        "stopwatch");
     RSS(ref_migrate_to_balance(ref_grid), "balance");
     RSS(ref_grid_pack(ref_grid), "pack");
-    ref_mpi_stopwatch_stop(ref_mpi, "pack");
-  }
+    RSS(stage_stopwatch_stop(ref_mpi, "pack"), "stopwatch");
+    pass_seconds[2] = subcommand_wall_time() - pass_time;
+    if (report_passes)
+      RSS(pass_report_write(ref_grid, pass, pass_seconds), "pass report");
+    if (conformity > 0.0) {
+      RSS(conformity_done(ref_grid, conformity, &last_conformity, &conformed),
+          "conformity");
+      RSS(stage_stopwatch_stop(ref_mpi, "edge conformity"), "stopwatch");
+      /* same guards as the other stop, quad and prism layers still form */
+      all_done = all_done || (conformed && (pass > MIN(5, passes)) &&
+                              !form_quads &&
+                              (!form_prism || pass >= passes / 2));
+    }
+  }
+  RSS(stage_pass_set(REF_EMPTY), "scope");
+  RSS(pass_report_close(), "close pass report");
 
   RXS(ref_args_find(argc, argv, "--usm3d", &pos), REF_NOT_FOUND, "parse usm3d");
   if (REF_EMPTY != pos) {
@@ -1115,10 +1743,10 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
 
   RSS(ref_node_implicit_global_from_local(ref_grid_node(ref_grid)),
       "implicit global");
-  ref_mpi_stopwatch_stop(ref_mpi, "implicit global");
+  RSS(stage_stopwatch_stop(ref_mpi, "implicit global"), "stopwatch");
 
   RSS(ref_geom_verify_param(ref_grid), "final params");
-  ref_mpi_stopwatch_stop(ref_mpi, "verify final params");
+  RSS(stage_stopwatch_stop(ref_mpi, "verify final params"), "stopwatch");
 
   /* export via -x grid.ext and -f final-surf.tec and -q final-vol.plt
      --export-metric-as final-metic.solb */
@@ -1245,16 +1873,16 @@ static REF_STATUS fossilize(REF_GRID ref_grid, const char *fossil_filename,
   if (ref_mpi_para(ref_mpi)) {
     if (ref_mpi_once(ref_mpi)) printf("part %s\n", fossil_filename);
     RSS(ref_part_by_extension(&fossil_grid, ref_mpi, fossil_filename), "part");
-    ref_mpi_stopwatch_stop(ref_mpi, "part");
+    RSS(stage_stopwatch_stop(ref_mpi, "part"), "stopwatch");
     ref_grid_partitioner(ref_grid) = REF_MIGRATE_SINGLE;
     RSS(ref_migrate_to_balance(ref_grid), "migrate to single part");
     RSS(ref_grid_pack(ref_grid), "pack");
-    ref_mpi_stopwatch_stop(ref_mpi, "pack");
+    RSS(stage_stopwatch_stop(ref_mpi, "pack"), "stopwatch");
   } else {
     if (ref_mpi_once(ref_mpi)) printf("import %s\n", fossil_filename);
     RSS(ref_import_by_extension(&fossil_grid, ref_mpi, fossil_filename),
         "import");
-    ref_mpi_stopwatch_stop(ref_mpi, "import");
+    RSS(stage_stopwatch_stop(ref_mpi, "import"), "stopwatch");
   }
 
   fossil_node = ref_grid_node(fossil_grid);
@@ -1293,7 +1921,7 @@ static REF_STATUS fossilize(REF_GRID ref_grid, const char *fossil_filename,
           "tetgen surface to volume",
           { report_interections(ref_grid, project); });
     }
-    ref_mpi_stopwatch_stop(ref_mpi, "tetgen volume");
+    RSS(stage_stopwatch_stop(ref_mpi, "tetgen volume"), "stopwatch");
   } else if (strncmp(mesher, "a", 1) == 0) {
     if (ref_mpi_once(ref_mpi)) {
       printf("fill volume with AFLR3\n");
@@ -1301,17 +1929,18 @@ static REF_STATUS fossilize(REF_GRID ref_grid, const char *fossil_filename,
           "aflr surface to volume",
           { report_interections(ref_grid, project); });
     }
-    ref_mpi_stopwatch_stop(ref_mpi, "aflr volume");
+    RSS(stage_stopwatch_stop(ref_mpi, "aflr volume"), "stopwatch");
   } else {
     if (ref_mpi_once(ref_mpi)) printf("mesher '%s' not implemented\n", mesher);
     return REF_FAILURE;
   }
   ref_grid_surf(ref_grid) = REF_FALSE; /* needed until vol mesher para */
   RSS(ref_validation_boundary_face(ref_grid), "boundary-interior connectivity");
-  ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "boundary-volume check");
+  RSS(stage_stopwatch_stop(ref_grid_mpi(ref_grid), "boundary-volume check"),
+      "stopwatch");
 
   RSS(ref_split_edge_geometry(ref_grid), "split geom");
-  ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "split geom");
+  RSS(stage_stopwatch_stop(ref_grid_mpi(ref_grid), "split geom"), "stopwatch");
   RSS(ref_node_synchronize_globals(ref_grid_node(ref_grid)), "sync glob");
 
   ref_cell = ref_grid_tri(ref_grid);
@@ -1345,17 +1974,18 @@ static REF_STATUS fossilize(REF_GRID ref_grid, const char *fossil_filename,
     printf("gather " REF_GLOB_FMT " nodes to %s\n",
            ref_node_n_global(ref_grid_node(ref_grid)), filename);
   RSS(ref_gather_by_extension(ref_grid, filename), "vol export");
-  ref_mpi_stopwatch_stop(ref_mpi, "export volume");
+  RSS(stage_stopwatch_stop(ref_mpi, "export volume"), "stopwatch");
 
   RSS(ref_validation_boundary_face(ref_grid), "boundary-interior connectivity");
-  ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "boundary-volume check");
+  RSS(stage_stopwatch_stop(ref_grid_mpi(ref_grid), "boundary-volume check"),
+      "stopwatch");
 
   snprintf(filename, 1024, "%s-vol.meshb", project);
   if (ref_mpi_once(ref_mpi))
     printf("gather " REF_GLOB_FMT " nodes to %s\n",
            ref_node_n_global(ref_grid_node(ref_grid)), filename);
   RSS(ref_gather_by_extension(ref_grid, filename), "vol export");
-  ref_mpi_stopwatch_stop(ref_mpi, "export volume");
+  RSS(stage_stopwatch_stop(ref_mpi, "export volume"), "stopwatch");
 
   ref_free(f2g);
   return REF_SUCCESS;
@@ -1416,7 +2046,7 @@ static REF_STATUS bootstrap(REF_MPI ref_mpi, int argc, char *argv[]) {
   RSS(ref_egads_load(ref_grid_geom(ref_grid), argv[2]), "ld egads");
   if (ref_mpi_once(ref_mpi) && ref_geom_effective(ref_grid_geom(ref_grid)))
     printf("EBody Effective Body loaded\n");
-  ref_mpi_stopwatch_stop(ref_mpi, "egads load");
+  RSS(stage_stopwatch_stop(ref_mpi, "egads load"), "stopwatch");
 
   if (ref_mpi_once(ref_mpi)) {
     REF_BOOL axi = REF_FALSE;
@@ -1479,46 +2109,46 @@ static REF_STATUS bootstrap(REF_MPI ref_mpi, int argc, char *argv[]) {
   RSS(ref_egads_tess(ref_grid, auto_tparams, global_params), "tess egads");
   ref_free(global_params);
   global_params = NULL;
-  ref_mpi_stopwatch_stop(ref_mpi, "egads tess");
+  RSS(stage_stopwatch_stop(ref_mpi, "egads tess"), "stopwatch");
   snprintf(filename, 1024, "%s-init-surf.tec", project);
   if (ref_mpi_once(ref_mpi))
     RSS(ref_export_tec_surf(ref_grid, filename), "dbg surf");
-  ref_mpi_stopwatch_stop(ref_mpi, "export init-surf");
+  RSS(stage_stopwatch_stop(ref_mpi, "export init-surf"), "stopwatch");
   snprintf(filename, 1024, "%s-init-geom.tec", project);
   if (ref_mpi_once(ref_mpi))
     RSS(ref_geom_tec(ref_grid, filename), "geom export");
-  ref_mpi_stopwatch_stop(ref_mpi, "export init-geom");
+  RSS(stage_stopwatch_stop(ref_mpi, "export init-geom"), "stopwatch");
   if (inspect_evaluation) {
     snprintf(filename, 1024, "%s-init-surf.meshb", project);
     if (ref_mpi_once(ref_mpi))
       RSS(ref_export_by_extension(ref_grid, filename), "dbg meshb");
-    ref_mpi_stopwatch_stop(ref_mpi, "export init-surf");
+    RSS(stage_stopwatch_stop(ref_mpi, "export init-surf"), "stopwatch");
   }
   if (ref_mpi_once(ref_mpi)) printf("verify topo\n");
   RSS(ref_geom_verify_topo(ref_grid), "adapt topo");
-  ref_mpi_stopwatch_stop(ref_mpi, "verify topo");
+  RSS(stage_stopwatch_stop(ref_mpi, "verify topo"), "stopwatch");
   if (ref_mpi_once(ref_mpi)) printf("verify EGADS param\n");
   RSS(ref_geom_verify_param(ref_grid), "egads params");
-  ref_mpi_stopwatch_stop(ref_mpi, "verify param");
+  RSS(stage_stopwatch_stop(ref_mpi, "verify param"), "stopwatch");
 
   if (ref_mpi_once(ref_mpi)) printf("constrain all\n");
   RSS(ref_geom_constrain_all(ref_grid), "constrain");
-  ref_mpi_stopwatch_stop(ref_mpi, "constrain param");
+  RSS(stage_stopwatch_stop(ref_mpi, "constrain param"), "stopwatch");
   if (ref_mpi_once(ref_mpi)) printf("verify constrained param\n");
   RSS(ref_geom_verify_param(ref_grid), "constrained params");
-  ref_mpi_stopwatch_stop(ref_mpi, "verify param");
+  RSS(stage_stopwatch_stop(ref_mpi, "verify param"), "stopwatch");
 
   if (inspect_evaluation) {
     snprintf(filename, 1024, "%s-const-geom.tec", project);
     if (ref_mpi_once(ref_mpi))
       RSS(ref_geom_tec(ref_grid, filename), "geom export");
-    ref_mpi_stopwatch_stop(ref_mpi, "export init-geom");
+    RSS(stage_stopwatch_stop(ref_mpi, "export init-geom"), "stopwatch");
   }
 
   if (ref_geom_manifold(ref_grid_geom(ref_grid))) {
     if (ref_mpi_once(ref_mpi)) printf("verify manifold\n");
     RSS(ref_validation_boundary_manifold(ref_grid), "manifold");
-    ref_mpi_stopwatch_stop(ref_mpi, "tess verification");
+    RSS(stage_stopwatch_stop(ref_mpi, "tess verification"), "stopwatch");
   } else {
     if (ref_mpi_once(ref_mpi)) printf("manifold not required for wirebody\n");
   }
@@ -1556,12 +2186,12 @@ static REF_STATUS bootstrap(REF_MPI ref_mpi, int argc, char *argv[]) {
   RSS(ref_geom_verify_topo(ref_grid), "adapt topo");
   if (ref_mpi_once(ref_mpi)) printf("verify param\n");
   RSS(ref_geom_verify_param(ref_grid), "adapt params");
-  ref_mpi_stopwatch_stop(ref_mpi, "surf verification");
+  RSS(stage_stopwatch_stop(ref_mpi, "surf verification"), "stopwatch");
 
   ref_grid_partitioner(ref_grid) = REF_MIGRATE_SINGLE;
   RSS(ref_migrate_to_balance(ref_grid), "migrate to single part");
   RSS(ref_grid_pack(ref_grid), "pack");
-  ref_mpi_stopwatch_stop(ref_mpi, "pack");
+  RSS(stage_stopwatch_stop(ref_mpi, "pack"), "stopwatch");
 
   snprintf(filename, 1024, "%s-adapt-surf.meshb", project);
   RSS(ref_gather_by_extension(ref_grid, filename), "gather surf meshb");
@@ -1573,11 +2203,11 @@ static REF_STATUS bootstrap(REF_MPI ref_mpi, int argc, char *argv[]) {
     RSS(ref_export_tec_surf(ref_grid, filename), "dbg surf");
   snprintf(filename, 1024, "%s-adapt-prop.tec", project);
   RSS(ref_gather_surf_status_tec(ref_grid, filename), "gather surf status");
-  ref_mpi_stopwatch_stop(ref_mpi, "export adapt surf");
+  RSS(stage_stopwatch_stop(ref_mpi, "export adapt surf"), "stopwatch");
 
   snprintf(filename, 1024, "%s-adapt-triage.tec", project);
   RSS(ref_geom_feedback(ref_grid, filename), "feedback");
-  ref_mpi_stopwatch_stop(ref_mpi, "geom feedback");
+  RSS(stage_stopwatch_stop(ref_mpi, "geom feedback"), "stopwatch");
 
   RXS(ref_args_find(argc, argv, "--facelift", &facelift_pos), REF_NOT_FOUND,
       "arg search");
@@ -1586,7 +2216,7 @@ static REF_STATUS bootstrap(REF_MPI ref_mpi, int argc, char *argv[]) {
       printf("--facelift %s requested\n", argv[facelift_pos + 1]);
       RSS(ref_facelift_attach(ref_grid), "attach");
     }
-    ref_mpi_stopwatch_stop(ref_mpi, "facelift attached");
+    RSS(stage_stopwatch_stop(ref_mpi, "facelift attached"), "stopwatch");
     if (ref_mpi_once(ref_mpi)) {
       REF_FACELIFT ref_facelift = ref_geom_facelift(ref_grid_geom(ref_grid));
       RSS(ref_export_by_extension(ref_facelift_grid(ref_facelift),
@@ -1595,15 +2225,15 @@ static REF_STATUS bootstrap(REF_MPI ref_mpi, int argc, char *argv[]) {
       snprintf(filename, 1024, "%s-facelift-geom.tec", project);
       RSS(ref_facelift_tec(ref_facelift, filename), "facelift viz");
     }
-    ref_mpi_stopwatch_stop(ref_mpi, "facelift dumped");
+    RSS(stage_stopwatch_stop(ref_mpi, "facelift dumped"), "stopwatch");
     RSS(ref_geom_constrain_all(ref_grid), "constrain");
-    ref_mpi_stopwatch_stop(ref_mpi, "constrain param");
+    RSS(stage_stopwatch_stop(ref_mpi, "constrain param"), "stopwatch");
     RSS(ref_geom_verify_param(ref_grid), "facelift params");
-    ref_mpi_stopwatch_stop(ref_mpi, "verify param");
+    RSS(stage_stopwatch_stop(ref_mpi, "verify param"), "stopwatch");
     RSS(ref_adapt_surf_to_geom(ref_grid, 3), "ad");
-    ref_mpi_stopwatch_stop(ref_mpi, "untangle");
+    RSS(stage_stopwatch_stop(ref_mpi, "untangle"), "stopwatch");
     RSS(ref_grid_pack(ref_grid), "pack");
-    ref_mpi_stopwatch_stop(ref_mpi, "pack");
+    RSS(stage_stopwatch_stop(ref_mpi, "pack"), "stopwatch");
   }
 
   RXS(ref_args_find(argc, argv, "--surrogate", &pos), REF_NOT_FOUND,
@@ -1634,7 +2264,7 @@ static REF_STATUS bootstrap(REF_MPI ref_mpi, int argc, char *argv[]) {
     RSS(ref_migrate_replicate_ghost(surrogate), "replicant");
     RSS(ref_facelift_create(&ref_facelift, surrogate, REF_TRUE), "create");
     ref_geom_facelift(ref_grid_geom(ref_grid)) = ref_facelift;
-    ref_mpi_stopwatch_stop(ref_mpi, "enrich attach surrogate");
+    RSS(stage_stopwatch_stop(ref_mpi, "enrich attach surrogate"), "stopwatch");
     RSS(ref_geom_constrain_all(ref_grid), "constrain");
     RSS(ref_geom_max_gap(ref_grid, &gap), "geom gap");
     if (ref_mpi_once(ref_mpi)) printf("surrogate gap %e\n", gap);
@@ -1642,7 +2272,7 @@ static REF_STATUS bootstrap(REF_MPI ref_mpi, int argc, char *argv[]) {
       printf("gather %s\n", argv[pos + 1]);
     }
     RSS(ref_gather_by_extension(surrogate, argv[pos + 1]), "gather surrogate");
-    ref_mpi_stopwatch_stop(ref_mpi, "gather surrogate");
+    RSS(stage_stopwatch_stop(ref_mpi, "gather surrogate"), "stopwatch");
   }
 
   RXS(ref_args_find(argc, argv, "--fossil", &pos), REF_NOT_FOUND, "arg search");
@@ -1664,7 +2294,7 @@ static REF_STATUS bootstrap(REF_MPI ref_mpi, int argc, char *argv[]) {
             "tetgen surface to volume",
             { report_interections(ref_grid, project); });
       }
-      ref_mpi_stopwatch_stop(ref_mpi, "tetgen volume");
+      RSS(stage_stopwatch_stop(ref_mpi, "tetgen volume"), "stopwatch");
     } else if (strncmp(mesher, "a", 1) == 0) {
       if (ref_mpi_once(ref_mpi)) {
         printf("fill volume with AFLR3\n");
@@ -1672,7 +2302,7 @@ static REF_STATUS bootstrap(REF_MPI ref_mpi, int argc, char *argv[]) {
             "aflr surface to volume",
             { report_interections(ref_grid, project); });
       }
-      ref_mpi_stopwatch_stop(ref_mpi, "aflr volume");
+      RSS(stage_stopwatch_stop(ref_mpi, "aflr volume"), "stopwatch");
     } else {
       if (ref_mpi_once(ref_mpi))
         printf("mesher '%s' not implemented\n", mesher);
@@ -1681,9 +2311,11 @@ static REF_STATUS bootstrap(REF_MPI ref_mpi, int argc, char *argv[]) {
     ref_grid_surf(ref_grid) = REF_FALSE; /* needed until vol mesher para */
     RSS(ref_validation_boundary_face(ref_grid),
         "boundary-interior connectivity");
-    ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "boundary-volume check");
+    RSS(stage_stopwatch_stop(ref_grid_mpi(ref_grid), "boundary-volume check"),
+        "stopwatch");
     RSS(ref_split_edge_geometry(ref_grid), "split geom");
-    ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "split geom");
+    RSS(stage_stopwatch_stop(ref_grid_mpi(ref_grid), "split geom"),
+        "stopwatch");
     {
       REF_DBL volume, min_volume, max_volume;
       REF_INT degree, max_degree;
@@ -1733,7 +2365,7 @@ static REF_STATUS bootstrap(REF_MPI ref_mpi, int argc, char *argv[]) {
     printf("gather " REF_GLOB_FMT " nodes to %s\n",
            ref_node_n_global(ref_grid_node(ref_grid)), filename);
   RSS(ref_gather_by_extension(ref_grid, filename), "vol export");
-  ref_mpi_stopwatch_stop(ref_mpi, "export volume");
+  RSS(stage_stopwatch_stop(ref_mpi, "export volume"), "stopwatch");
 
   RSS(ref_validation_cell_volume(ref_grid), "vol");
 
@@ -1886,20 +2518,20 @@ static REF_STATUS collar(REF_MPI ref_mpi, int argc, char *argv[]) {
     goto shutdown;
   }
 
-  ref_mpi_stopwatch_start(ref_mpi);
+  RSS(stage_stopwatch_start(ref_mpi), "stopwatch");
 
   if (ref_mpi_para(ref_mpi)) {
     if (ref_mpi_once(ref_mpi)) printf("part %s\n", input_filename);
     RSS(ref_part_by_extension(&ref_grid, ref_mpi, input_filename), "part");
-    ref_mpi_stopwatch_stop(ref_mpi, "core part");
+    RSS(stage_stopwatch_stop(ref_mpi, "core part"), "stopwatch");
     RSS(ref_migrate_to_balance(ref_grid), "balance");
-    ref_mpi_stopwatch_stop(ref_mpi, "balance core");
+    RSS(stage_stopwatch_stop(ref_mpi, "balance core"), "stopwatch");
     RSS(ref_grid_pack(ref_grid), "pack");
-    ref_mpi_stopwatch_stop(ref_mpi, "pack core");
+    RSS(stage_stopwatch_stop(ref_mpi, "pack core"), "stopwatch");
   } else {
     if (ref_mpi_once(ref_mpi)) printf("import %s\n", input_filename);
     RSS(ref_import_by_extension(&ref_grid, ref_mpi, input_filename), "import");
-    ref_mpi_stopwatch_stop(ref_mpi, "core import");
+    RSS(stage_stopwatch_stop(ref_mpi, "core import"), "stopwatch");
   }
   if (ref_mpi_once(ref_mpi))
     printf("  read " REF_GLOB_FMT " vertices\n",
@@ -1973,7 +2605,7 @@ static REF_STATUS collar(REF_MPI ref_mpi, int argc, char *argv[]) {
              ref_node_n_global(ref_grid_node(ref_grid)));
   }
 
-  ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "inflate");
+  RSS(stage_stopwatch_stop(ref_grid_mpi(ref_grid), "inflate"), "stopwatch");
 
   if (ref_mpi_once(ref_mpi)) {
     printf("inflated %d faces\n", ref_dict_n(faceids));
@@ -1995,13 +2627,15 @@ static REF_STATUS collar(REF_MPI ref_mpi, int argc, char *argv[]) {
           printf("gather " REF_GLOB_FMT " nodes to %s\n",
                  ref_node_n_global(ref_grid_node(ref_grid)), argv[opt + 1]);
         RSS(ref_gather_by_extension(ref_grid, argv[opt + 1]), "gather -x");
-        ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "gather");
+        RSS(stage_stopwatch_stop(ref_grid_mpi(ref_grid), "gather"),
+            "stopwatch");
       } else {
         if (ref_mpi_once(ref_mpi))
           printf("export " REF_GLOB_FMT " nodes to %s\n",
                  ref_node_n_global(ref_grid_node(ref_grid)), argv[opt + 1]);
         RSS(ref_export_by_extension(ref_grid, argv[opt + 1]), "export -x");
-        ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "export");
+        RSS(stage_stopwatch_stop(ref_grid_mpi(ref_grid), "export"),
+            "stopwatch");
       }
     }
   }
@@ -2011,7 +2645,7 @@ static REF_STATUS collar(REF_MPI ref_mpi, int argc, char *argv[]) {
       printf("gather " REF_GLOB_FMT " nodes to %s\n",
              ref_node_n_global(ref_grid_node(ref_grid)), "inflated.b8.ugrid");
     RSS(ref_gather_by_extension(ref_grid, "inflated.b8.ugrid"), "gather");
-    ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "gather");
+    RSS(stage_stopwatch_stop(ref_grid_mpi(ref_grid), "gather"), "stopwatch");
   }
 
   RSS(ref_dict_free(faceids), "free");
@@ -2082,11 +2716,11 @@ static REF_STATUS distance(REF_MPI ref_mpi, int argc, char *argv[]) {
   if (ref_mpi_para(ref_mpi)) {
     if (ref_mpi_once(ref_mpi)) printf("part %s\n", in_mesh);
     RSS(ref_part_by_extension(&ref_grid, ref_mpi, in_mesh), "part");
-    ref_mpi_stopwatch_stop(ref_mpi, "part");
+    RSS(stage_stopwatch_stop(ref_mpi, "part"), "stopwatch");
   } else {
     if (ref_mpi_once(ref_mpi)) printf("import %s\n", in_mesh);
     RSS(ref_import_by_extension(&ref_grid, ref_mpi, in_mesh), "import");
-    ref_mpi_stopwatch_stop(ref_mpi, "import");
+    RSS(stage_stopwatch_stop(ref_mpi, "import"), "stopwatch");
   }
   if (ref_mpi_once(ref_mpi))
     printf("  read " REF_GLOB_FMT " vertices\n",
@@ -2115,16 +2749,17 @@ static REF_STATUS distance(REF_MPI ref_mpi, int argc, char *argv[]) {
   RXS(ref_args_find(argc, argv, "--static", &pos), REF_NOT_FOUND, "arg search");
   if (REF_EMPTY == pos) {
     RSS(ref_phys_wall_distance(ref_grid, ref_dict_bcs, distance), "store");
-    ref_mpi_stopwatch_stop(ref_mpi, "wall distance");
+    RSS(stage_stopwatch_stop(ref_mpi, "wall distance"), "stopwatch");
   } else {
     RSS(ref_phys_wall_distance_static(ref_grid, ref_dict_bcs, distance),
         "store");
-    ref_mpi_stopwatch_stop(ref_mpi, "wall distance not balanced");
+    RSS(stage_stopwatch_stop(ref_mpi, "wall distance not balanced"),
+        "stopwatch");
   }
   if (ref_mpi_once(ref_mpi)) printf("gather %s\n", out_file);
   RSS(ref_gather_scalar_by_extension(ref_grid, 1, distance, NULL, out_file),
       "gather");
-  ref_mpi_stopwatch_stop(ref_mpi, "gather");
+  RSS(stage_stopwatch_stop(ref_mpi, "gather"), "stopwatch");
 
   ref_free(distance);
   ref_dict_free(ref_dict_bcs);
@@ -2147,150 +2782,979 @@ shutdown:
   return REF_FAILURE;
 }
 
-static REF_STATUS grow(REF_MPI ref_mpi, int argc, char *argv[]) {
-  char *out_file;
-  char *in_file;
-  char project[1000];
-  size_t end_of_string;
-  REF_GRID ref_grid = NULL;
-  const char *mesher = "tetgen";
-  const char *mesher_options = NULL;
-  REF_INT pos;
+/* FUN3D nondimensional [rho,u,v,w,p] of a tanh shock at x = shock
+ * (density doubles, Mach 2 to subsonic) over a tanh boundary layer on y=0 */
+static REF_STATUS fixture_flow(REF_DBL *xyz, REF_DBL shock, REF_DBL *prim) {
+  REF_DBL gamma = 1.4;
+  REF_DBL jump, layer;
+  jump = 0.5 * (1.0 + tanh((xyz[0] - shock) / 0.02));
+  layer = tanh(xyz[1] / 0.05);
+  prim[0] = 1.0 + jump;
+  prim[1] = 2.0 * (1.0 - 0.5 * jump) * layer;
+  prim[2] = 0.0;
+  prim[3] = 0.0;
+  prim[4] = (1.0 + 3.5 * jump) / gamma;
+  return REF_SUCCESS;
+}
 
-  if (ref_mpi_para(ref_mpi)) {
-    RSS(REF_IMPLEMENT, "ref grow is not parallel");
+/* part owning node plane i of ncell cell planes split into slabs */
+static REF_INT fixture_plane_part(REF_INT i, REF_INT ncell, REF_INT nranks) {
+  REF_INT rank;
+  for (rank = 0; rank < nranks; rank++) {
+    if (i < ((REF_LONG)(rank + 1) * (REF_LONG)ncell) / nranks) return rank;
   }
-  if (argc < 4) goto shutdown;
-  in_file = argv[2];
-  out_file = argv[3];
-  end_of_string = MIN(1023, strlen(argv[2]));
-  if (7 > end_of_string ||
-      strncmp(&(argv[2][end_of_string - 6]), ".meshb", 6) != 0)
-    goto shutdown;
-  strncpy(project, argv[2], end_of_string - 6);
-  project[end_of_string - 6] = '\0';
+  return nranks - 1;
+}
 
-  printf("import %s\n", in_file);
-  RSS(ref_import_by_extension(&ref_grid, ref_mpi, in_file), "load surface");
+static REF_STATUS fixture_add_tri(REF_GRID ref_grid, REF_INT *nodes,
+                                  REF_INT faceid, REF_DBL *outward) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_DBL edge0[3], edge1[3], normal[3];
+  REF_INT i, temp, cell;
+  for (i = 0; i < 3; i++) {
+    edge0[i] = ref_node_xyz(ref_node, i, nodes[1]) -
+               ref_node_xyz(ref_node, i, nodes[0]);
+    edge1[i] = ref_node_xyz(ref_node, i, nodes[2]) -
+               ref_node_xyz(ref_node, i, nodes[0]);
+  }
+  ref_math_cross_product(edge0, edge1, normal);
+  if (ref_math_dot(normal, outward) < 0.0) {
+    temp = nodes[1];
+    nodes[1] = nodes[2];
+    nodes[2] = temp;
+  }
+  nodes[3] = faceid;
+  RSS(ref_cell_add(ref_grid_tri(ref_grid), nodes, &cell), "add tri");
+  return REF_SUCCESS;
+}
 
-  RXS(ref_args_find(argc, argv, "--mesher", &pos), REF_NOT_FOUND, "arg search");
-  if (REF_EMPTY != pos && pos < argc - 1) {
-    mesher = argv[pos + 1];
-    if (ref_mpi_once(ref_mpi)) printf("--mesher %s requested\n", mesher);
-  }
+/* structured brick of Kuhn (6 tet) hexes, each rank builds an x slab
+ * plus the layer below it, so every cell touching an owned node is
+ * present with the previous plane as ghosts (as ref_part provides) */
+static REF_STATUS fixture_brick(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
+                                REF_INT nx, REF_INT ny, REF_INT nz,
+                                REF_DBL *length, REF_BOOL wall_spacing) {
+  REF_GRID ref_grid;
+  REF_NODE ref_node;
+  REF_INT i0, i1, ighost, i, j, k, perm, corner, cell, temp;
+  REF_INT *local, hex[8], nodes[REF_CELL_MAX_SIZE_PER];
+  REF_INT kuhn[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2},
+                        {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+  REF_INT bit[3] = {1, 2, 4};
+  REF_DBL edge0[3], edge1[3], edge2[3], normal[3];
+  REF_DBL outward[3];
+  REF_GLOB global;
+  REF_INT plane_size = ny * nz;
+  REF_DBL eta, beta = 3.0;
 
-  RXS(ref_args_find(argc, argv, "--mesher-options", &pos), REF_NOT_FOUND,
-      "arg search");
-  if (REF_EMPTY != pos && pos < argc - 1) {
-    mesher_options = argv[pos + 1];
-    if (ref_mpi_once(ref_mpi))
-      printf("--mesher-options %s requested\n", mesher_options);
-  }
+  RSS(ref_grid_create(ref_grid_ptr, ref_mpi), "create");
+  ref_grid = *ref_grid_ptr;
+  ref_node = ref_grid_node(ref_grid);
 
-  if (strncmp(mesher, "t", 1) == 0) {
-    if (ref_mpi_once(ref_mpi)) {
-      printf("fill volume with TetGen\n");
-      RSB(ref_geom_tetgen_volume(ref_grid, project, mesher_options),
-          "tetgen surface to volume",
-          { report_interections(ref_grid, project); });
+  i0 = (REF_INT)(((REF_LONG)ref_mpi_rank(ref_mpi) * (REF_LONG)(nx - 1)) /
+                 ref_mpi_n(ref_mpi));
+  i1 = (REF_INT)(((REF_LONG)(ref_mpi_rank(ref_mpi) + 1) * (REF_LONG)(nx - 1)) /
+                 ref_mpi_n(ref_mpi));
+
+  RSS(ref_node_initialize_n_global(
+          ref_node, (REF_GLOB)nx * (REF_GLOB)ny * (REF_GLOB)nz),
+      "init n global");
+  if (i0 == i1) return REF_SUCCESS;
+  ighost = MAX(0, i0 - 1);
+
+  ref_malloc(local, (i1 - ighost + 1) * plane_size, REF_INT);
+  for (i = ighost; i <= i1; i++) {
+    for (j = 0; j < ny; j++) {
+      for (k = 0; k < nz; k++) {
+        global = (REF_GLOB)k + (REF_GLOB)nz * ((REF_GLOB)j +
+                                               (REF_GLOB)ny * (REF_GLOB)i);
+        RSS(ref_node_add(ref_node, global,
+                         &(local[k + nz * j + plane_size * (i - ighost)])),
+            "add node");
+        temp = local[k + nz * j + plane_size * (i - ighost)];
+        eta = (REF_DBL)j / (REF_DBL)(ny - 1);
+        if (wall_spacing) eta = (exp(beta * eta) - 1.0) / (exp(beta) - 1.0);
+        ref_node_xyz(ref_node, 0, temp) =
+            length[0] * (REF_DBL)i / (REF_DBL)(nx - 1);
+        ref_node_xyz(ref_node, 1, temp) = length[1] * eta;
+        ref_node_xyz(ref_node, 2, temp) =
+            length[2] * (REF_DBL)k / (REF_DBL)(nz - 1);
+        ref_node_part(ref_node, temp) =
+            fixture_plane_part(i, nx - 1, ref_mpi_n(ref_mpi));
+      }
     }
-    ref_mpi_stopwatch_stop(ref_mpi, "tetgen volume");
-  } else if (strncmp(mesher, "a", 1) == 0) {
-    if (ref_mpi_once(ref_mpi)) {
-      printf("fill volume with AFLR3\n");
-      RSB(ref_geom_aflr_volume(ref_grid, project, mesher_options),
-          "aflr surface to volume",
-          { report_interections(ref_grid, project); });
+  }
+
+  for (i = ighost; i < i1; i++) {
+    for (j = 0; j < ny - 1; j++) {
+      for (k = 0; k < nz - 1; k++) {
+        for (corner = 0; corner < 8; corner++) {
+          hex[corner] = local[(k + ((corner & 4) ? 1 : 0)) +
+                              nz * (j + ((corner & 2) ? 1 : 0)) +
+                              plane_size *
+                                  (i - ighost + ((corner & 1) ? 1 : 0))];
+        }
+        for (perm = 0; perm < 6; perm++) {
+          nodes[0] = hex[0];
+          nodes[1] = hex[bit[kuhn[perm][0]]];
+          nodes[2] = hex[bit[kuhn[perm][0]] | bit[kuhn[perm][1]]];
+          nodes[3] = hex[7];
+          for (corner = 0; corner < 3; corner++) {
+            edge0[corner] = ref_node_xyz(ref_node, corner, nodes[1]) -
+                            ref_node_xyz(ref_node, corner, nodes[0]);
+            edge1[corner] = ref_node_xyz(ref_node, corner, nodes[2]) -
+                            ref_node_xyz(ref_node, corner, nodes[0]);
+            edge2[corner] = ref_node_xyz(ref_node, corner, nodes[3]) -
+                            ref_node_xyz(ref_node, corner, nodes[0]);
+          }
+          ref_math_cross_product(edge0, edge1, normal);
+          if (ref_math_dot(normal, edge2) < 0.0) {
+            temp = nodes[1];
+            nodes[1] = nodes[2];
+            nodes[2] = temp;
+          }
+          RSS(ref_cell_add(ref_grid_tet(ref_grid), nodes, &cell), "add tet");
+        }
+        /* faces split on the same min-max diagonal as the Kuhn tets */
+        if (0 == j) {
+          outward[0] = 0.0, outward[1] = -1.0, outward[2] = 0.0;
+          nodes[0] = hex[0], nodes[1] = hex[1], nodes[2] = hex[5];
+          RSS(fixture_add_tri(ref_grid, nodes, 3, outward), "y0");
+          nodes[0] = hex[0], nodes[1] = hex[5], nodes[2] = hex[4];
+          RSS(fixture_add_tri(ref_grid, nodes, 3, outward), "y0");
+        }
+        if (ny - 2 == j) {
+          outward[0] = 0.0, outward[1] = 1.0, outward[2] = 0.0;
+          nodes[0] = hex[2], nodes[1] = hex[3], nodes[2] = hex[7];
+          RSS(fixture_add_tri(ref_grid, nodes, 4, outward), "y1");
+          nodes[0] = hex[2], nodes[1] = hex[7], nodes[2] = hex[6];
+          RSS(fixture_add_tri(ref_grid, nodes, 4, outward), "y1");
+        }
+        if (0 == k) {
+          outward[0] = 0.0, outward[1] = 0.0, outward[2] = -1.0;
+          nodes[0] = hex[0], nodes[1] = hex[1], nodes[2] = hex[3];
+          RSS(fixture_add_tri(ref_grid, nodes, 5, outward), "z0");
+          nodes[0] = hex[0], nodes[1] = hex[3], nodes[2] = hex[2];
+          RSS(fixture_add_tri(ref_grid, nodes, 5, outward), "z0");
+        }
+        if (nz - 2 == k) {
+          outward[0] = 0.0, outward[1] = 0.0, outward[2] = 1.0;
+          nodes[0] = hex[4], nodes[1] = hex[5], nodes[2] = hex[7];
+          RSS(fixture_add_tri(ref_grid, nodes, 6, outward), "z1");
+          nodes[0] = hex[4], nodes[1] = hex[7], nodes[2] = hex[6];
+          RSS(fixture_add_tri(ref_grid, nodes, 6, outward), "z1");
+        }
+        if (0 == i) {
+          outward[0] = -1.0, outward[1] = 0.0, outward[2] = 0.0;
+          nodes[0] = hex[0], nodes[1] = hex[2], nodes[2] = hex[6];
+          RSS(fixture_add_tri(ref_grid, nodes, 1, outward), "x0");
+          nodes[0] = hex[0], nodes[1] = hex[6], nodes[2] = hex[4];
+          RSS(fixture_add_tri(ref_grid, nodes, 1, outward), "x0");
+        }
+        if (nx - 2 == i) {
+          outward[0] = 1.0, outward[1] = 0.0, outward[2] = 0.0;
+          nodes[0] = hex[1], nodes[1] = hex[3], nodes[2] = hex[7];
+          RSS(fixture_add_tri(ref_grid, nodes, 2, outward), "x1");
+          nodes[0] = hex[1], nodes[1] = hex[7], nodes[2] = hex[5];
+          RSS(fixture_add_tri(ref_grid, nodes, 2, outward), "x1");
+        }
+      }
     }
-    ref_mpi_stopwatch_stop(ref_mpi, "aflr volume");
-  } else {
-    printf("mesher '%s' not implemented\n", mesher);
+  }
+  ref_free(local);
+  return REF_SUCCESS;
+}
+
+static REF_STATUS fixture(REF_MPI ref_mpi, int argc, char *argv[]) {
+  char *out_project;
+  char filename[1024];
+  REF_GRID ref_grid = NULL;
+  REF_NODE ref_node;
+  REF_GLOB target;
+  REF_INT nx, ny, nz, node, pos, timestep, timesteps = 0;
+  REF_DBL length[3] = {1.0, 1.0, 1.0};
+  REF_BOOL channel = REF_FALSE;
+  REF_DBL *field, shock;
+
+  if (argc < 4) goto shutdown;
+  out_project = argv[2];
+  target = (REF_GLOB)atof(argv[3]);
+  if (target < 8) {
+    if (ref_mpi_once(ref_mpi))
+      printf("node count " REF_GLOB_FMT " must be at least 8\n", target);
     goto shutdown;
   }
 
-  ref_grid_surf(ref_grid) = REF_FALSE; /* needed until vol mesher para */
-  RSS(ref_validation_boundary_face(ref_grid), "boundary-interior connectivity");
-  ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "boundary-volume check");
+  RXS(ref_args_find(argc, argv, "--channel", &pos), REF_NOT_FOUND,
+      "arg search");
+  channel = (REF_EMPTY != pos);
 
-  RSS(ref_split_edge_geometry(ref_grid), "split geom");
-  ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "split geom");
+  RXS(ref_args_find(argc, argv, "--series", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    if (pos >= argc - 1) {
+      if (ref_mpi_once(ref_mpi)) printf("--series requires <timesteps>\n");
+      goto shutdown;
+    }
+    timesteps = atoi(argv[pos + 1]);
+  }
 
-  RSS(ref_node_synchronize_globals(ref_grid_node(ref_grid)), "sync glob");
+  if (channel) {
+    length[0] = 4.0;
+    ny = MAX(2, (REF_INT)round(cbrt((REF_DBL)target / 4.0)));
+    nx = MAX(2, 4 * ny);
+  } else {
+    ny = MAX(2, (REF_INT)round(cbrt((REF_DBL)target)));
+    nx = ny;
+  }
+  nz = ny;
 
-  printf("export %s\n", out_file);
-  RSS(ref_export_by_extension(ref_grid, out_file), "vol export");
+  if (ref_mpi_once(ref_mpi))
+    printf("%s %d x %d x %d brick, " REF_GLOB_FMT " nodes, %d ranks\n",
+           channel ? "channel" : "box", nx, ny, nz,
+           (REF_GLOB)nx * (REF_GLOB)ny * (REF_GLOB)nz, ref_mpi_n(ref_mpi));
+  RSS(fixture_brick(&ref_grid, ref_mpi, nx, ny, nz, length, channel),
+      "brick");
+  ref_node = ref_grid_node(ref_grid);
+  RSS(stage_stopwatch_stop(ref_mpi, "generate brick"), "stopwatch");
 
-  RSS(ref_validation_cell_volume(ref_grid), "vol");
+  snprintf(filename, 1024, "%s.meshb", out_project);
+  if (ref_mpi_once(ref_mpi))
+    printf("gather " REF_GLOB_FMT " nodes to %s\n",
+           ref_node_n_global(ref_node), filename);
+  RSS(ref_gather_by_extension(ref_grid, filename), "gather meshb");
+  RSS(stage_stopwatch_stop(ref_mpi, "gather meshb"), "stopwatch");
 
-  RSS(ref_grid_free(ref_grid), "create");
+  if (ref_mpi_once(ref_mpi)) {
+    FILE *file;
+    snprintf(filename, 1024, "%s.mapbc", out_project);
+    printf("write boundary conditions to %s\n", filename);
+    file = fopen(filename, "w");
+    if (NULL == (void *)file) printf("unable to open %s\n", filename);
+    RNS(file, "unable to open file");
+    fprintf(file, "6\n");
+    fprintf(file, "1 5000 inflow\n");
+    fprintf(file, "2 5000 outflow\n");
+    fprintf(file, "3 4000 wall\n");
+    fprintf(file, "4 5000 top\n");
+    fprintf(file, "5 6663 side\n");
+    fprintf(file, "6 6663 side\n");
+    fclose(file);
+  }
+
+  ref_malloc(field, 5 * ref_node_max(ref_node), REF_DBL);
+  each_ref_node_valid_node(ref_node, node) {
+    RSS(fixture_flow(ref_node_xyz_ptr(ref_node, node), 0.5 * length[0],
+                     &(field[5 * node])),
+        "flow");
+  }
+  snprintf(filename, 1024, "%s_volume.solb", out_project);
+  if (ref_mpi_once(ref_mpi)) printf("gather [rho,u,v,w,p] to %s\n", filename);
+  RSS(ref_gather_scalar_by_extension(ref_grid, 5, field, NULL, filename),
+      "gather volume");
+  RSS(stage_stopwatch_stop(ref_mpi, "gather volume"), "stopwatch");
+
+  /* density of the shock sweeping through the middle of the domain */
+  for (timestep = 1; timestep <= timesteps; timestep++) {
+    REF_DBL prim[5];
+    shock = length[0] * (0.3 + 0.4 * (REF_DBL)(timestep - 1) /
+                                   (REF_DBL)MAX(1, timesteps - 1));
+    each_ref_node_valid_node(ref_node, node) {
+      RSS(fixture_flow(ref_node_xyz_ptr(ref_node, node), shock, prim),
+          "flow");
+      field[node] = prim[0];
+    }
+    snprintf(filename, 1024, "%s_timestep%d.solb", out_project, timestep);
+    if (ref_mpi_once(ref_mpi)) printf("gather density to %s\n", filename);
+    RSS(ref_gather_scalar_by_extension(ref_grid, 1, field, NULL, filename),
+        "gather timestep");
+  }
+  if (0 < timesteps)
+    RSS(stage_stopwatch_stop(ref_mpi, "gather series"), "stopwatch");
+
+  ref_free(field);
+  RSS(ref_grid_free(ref_grid), "free grid");
 
   return REF_SUCCESS;
 shutdown:
-  if (ref_mpi_once(ref_mpi)) grow_help(argv[0]);
+  if (ref_mpi_once(ref_mpi)) fixture_help(argv[0]);
   return REF_FAILURE;
 }
 
-REF_FCN static REF_STATUS ref_grid_extrude_field(REF_GRID twod_grid,
-                                                 REF_INT ldim,
-                                                 REF_DBL *twod_field,
-                                                 REF_GRID extruded_grid,
-                                                 REF_DBL *extruded_field) {
-  REF_NODE ref_node;
-  REF_SEARCH ref_search;
-  REF_LIST touching;
-  REF_INT node, candidate, best, item, i;
-  REF_DBL dist, radius, best_dist, position[3];
-  REF_BOOL verbose = REF_FALSE;
-  RSS(ref_list_create(&touching), "touching list");
-  ref_node = ref_grid_node(twod_grid);
-  RSS(ref_search_create(&ref_search, ref_node_n(ref_node)), "create search");
-  each_ref_node_valid_node(ref_node, node) {
-    radius = 0.0;
-    RSS(ref_search_insert(ref_search, node, ref_node_xyz_ptr(ref_node, node),
-                          radius),
-        "ins");
-  }
-  ref_node = ref_grid_node(extruded_grid);
-  each_ref_node_valid_node(ref_node, node) {
-    position[0] = ref_node_xyz(ref_grid_node(extruded_grid), 0, node);
+#define REF_BENCH_STAGES (9)
+
+static REF_STATUS bench_baseline(const char *filename, const char **stages,
+                                 REF_DBL *baseline) {
+  FILE *file;
+  char line[1024], name[256];
+  double mean;
+  REF_INT stage;
+  for (stage = 0; stage < REF_BENCH_STAGES; stage++) baseline[stage] = -1.0;
+  file = fopen(filename, "r");
+  if (NULL == (void *)file) printf("unable to open %s\n", filename);
+  RNS(file, "unable to open file");
+  while (NULL != fgets(line, 1024, file)) {
+    if (2 != sscanf(line, " \"%255[^\"]\": {\"mean\": %lf", name, &mean))
+      continue;
+    for (stage = 0; stage < REF_BENCH_STAGES; stage++)
+      if (0 == strcmp(name, stages[stage])) baseline[stage] = mean;
+  }
+  fclose(file);
+  return REF_SUCCESS;
+}
+
+static REF_STATUS bench(REF_MPI ref_mpi, int argc, char *argv[]) {
+  const char *stages[REF_BENCH_STAGES] = {
+      "part",      "wall distance", "recon hessian",
+      "metric lp", "intersect",     "gradation",
+      "adapt pass", "interp locate", "gather metric"};
+  char *in_mesh;
+  char *end;
+  char filename[1024];
+  REF_GRID ref_grid = NULL, background = NULL;
+  REF_DICT ref_dict_bcs = NULL;
+  REF_INTERP ref_interp = NULL;
+  REF_DBL *distance = NULL, *scalar = NULL, *hess = NULL, *metric = NULL;
+  REF_DBL *seconds = NULL, *nodes = NULL;
+  REF_DBL baseline[REF_BENCH_STAGES];
+  REF_DBL complexity = 1000.0, gradation = -1.0, aspect_ratio = -1.0;
+  REF_DBL start, elapsed, max_elapsed, prim[5], m[6], iso[6];
+  REF_GLOB target = 0;
+  REF_INT trials = 3, trial, stage, node, pos, nx;
+  REF_INT p = 2;
+  const char *save = NULL;
+  const char *compare = NULL;
+  REF_BOOL all_done = REF_FALSE;
+  REF_BOOL wall;
+
+  if (argc < 3) goto shutdown;
+  in_mesh = argv[2];
+  target = (REF_GLOB)strtod(in_mesh, &end);
+  if ('\0' != *end) target = 0;
+
+  RXS(ref_args_find(argc, argv, "--trials", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos && pos < argc - 1) trials = MAX(1, atoi(argv[pos + 1]));
+  RXS(ref_args_find(argc, argv, "--complexity", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos && pos < argc - 1) complexity = atof(argv[pos + 1]);
+  RXS(ref_args_find(argc, argv, "--save", &pos), REF_NOT_FOUND, "arg search");
+  if (REF_EMPTY != pos && pos < argc - 1) save = argv[pos + 1];
+  RXS(ref_args_find(argc, argv, "--baseline", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos && pos < argc - 1) compare = argv[pos + 1];
+
+  RSS(ref_dict_create(&ref_dict_bcs), "create");
+  RXS(ref_args_find(argc, argv, "--fun3d-mapbc", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos && pos < argc - 1) {
+    if (ref_mpi_once(ref_mpi)) {
+      printf("reading fun3d bc map %s\n", argv[pos + 1]);
+      RSS(ref_phys_read_mapbc(ref_dict_bcs, argv[pos + 1]),
+          "unable to read fun3d formatted mapbc");
+    }
+    RSS(ref_dict_bcast(ref_dict_bcs, ref_mpi), "bcast");
+  }
+  RXS(ref_args_find(argc, argv, "--viscous-tags", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos && pos < argc - 1) {
+    if (ref_mpi_once(ref_mpi)) {
+      RSS(ref_phys_parse_tags(ref_dict_bcs, argv[pos + 1]),
+          "unable to parse viscous tags");
+    }
+    RSS(ref_dict_bcast(ref_dict_bcs, ref_mpi), "bcast");
+  }
+  if (0 < target && 0 == ref_dict_n(ref_dict_bcs)) {
+    /* fixture wall is faceid 3 */
+    if (ref_mpi_once(ref_mpi)) {
+      RSS(ref_phys_parse_tags(ref_dict_bcs, "3"), "fixture wall");
+    }
+    RSS(ref_dict_bcast(ref_dict_bcs, ref_mpi), "bcast");
+  }
+
+  wall = (0 < ref_dict_n(ref_dict_bcs));
+  if (!wall && ref_mpi_once(ref_mpi))
+    printf("no viscous tags, skipping wall distance\n");
+  if (0 < target) {
+    stages[0] = "generate";
+  } else if (ref_mpi_para(ref_mpi)) {
+    stages[0] = "part";
+  } else {
+    stages[0] = "import";
+  }
+
+  if (ref_mpi_once(ref_mpi)) {
+    ref_malloc_init(seconds, trials * REF_BENCH_STAGES, REF_DBL, 0.0);
+    ref_malloc_init(nodes, REF_BENCH_STAGES, REF_DBL, 0.0);
+  }
+
+  for (trial = 0; trial < trials; trial++) {
+    if (ref_mpi_once(ref_mpi)) printf("\n trial %d of %d\n", trial + 1, trials);
+    snprintf(filename, 1024, "trial %d", trial + 1);
+    RSS(stage_scope_set(filename), "scope");
+    for (stage = 0; stage < REF_BENCH_STAGES; stage++) {
+      if (1 == stage && !wall) {
+        /* not timed, so --baseline never compares an empty stage */
+        if (ref_mpi_once(ref_mpi))
+          seconds[stage + REF_BENCH_STAGES * trial] = -1.0;
+        continue;
+      }
+      if (6 == stage) {
+        /* interp locate donor, copied outside the adapt pass timing */
+        RSS(ref_grid_deep_copy(&background, ref_grid), "background");
+        RSS(stage_stopwatch_stop(ref_mpi, "background copy"), "stopwatch");
+      }
+      start = subcommand_wall_time();
+      switch (stage) {
+        case 0:
+          if (0 < target) {
+            nx = MAX(2, (REF_INT)round(cbrt((REF_DBL)target)));
+            iso[0] = 1.0, iso[1] = 1.0, iso[2] = 1.0;
+            RSS(fixture_brick(&ref_grid, ref_mpi, nx, nx, nx, iso, REF_FALSE),
+                "brick");
+          } else if (ref_mpi_para(ref_mpi)) {
+            RSS(ref_part_by_extension(&ref_grid, ref_mpi, in_mesh), "part");
+          } else {
+            RSS(ref_import_by_extension(&ref_grid, ref_mpi, in_mesh),
+                "import");
+          }
+          break;
+        case 1:
+          ref_malloc_init(distance, ref_node_max(ref_grid_node(ref_grid)),
+                          REF_DBL, -1.0);
+          RSS(ref_phys_wall_distance(ref_grid, ref_dict_bcs, distance),
+              "wall distance");
+          ref_free(distance);
+          break;
+        case 2:
+          ref_malloc(scalar, ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
+          ref_malloc(hess, 6 * ref_node_max(ref_grid_node(ref_grid)),
+                     REF_DBL);
+          each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
+            RSS(fixture_flow(ref_node_xyz_ptr(ref_grid_node(ref_grid), node),
+                             0.5, prim),
+                "flow");
+            scalar[node] = prim[0];
+          }
+          RSS(ref_recon_hessian(ref_grid, scalar, hess,
+                                REF_RECON_L2PROJECTION),
+              "hess");
+          ref_free(hess);
+          break;
+        case 3:
+          ref_malloc(metric, 6 * ref_node_max(ref_grid_node(ref_grid)),
+                     REF_DBL);
+          RSS(ref_metric_lp(metric, ref_grid, scalar, REF_RECON_L2PROJECTION,
+                            p, gradation, aspect_ratio, complexity),
+              "lp norm");
+          ref_free(scalar);
+          break;
+        case 4:
+          /* isotropic ceiling of a tenth of the unit box */
+          iso[0] = 100.0, iso[1] = 0.0, iso[2] = 0.0;
+          iso[3] = 100.0, iso[4] = 0.0, iso[5] = 100.0;
+          each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
+            RSS(ref_matrix_intersect(&(metric[6 * node]), iso, m),
+                "intersect");
+            for (pos = 0; pos < 6; pos++) metric[pos + 6 * node] = m[pos];
+          }
+          break;
+        case 5:
+          RSS(ref_metric_gradation_at_complexity(metric, ref_grid, 1.5,
+                                                 complexity),
+              "gradation at complexity");
+          RSS(ref_metric_to_node(metric, ref_grid_node(ref_grid)),
+              "node metric");
+          ref_free(metric);
+          break;
+        case 6:
+          RSS(ref_adapt_pass(ref_grid, &all_done), "pass");
+          break;
+        case 7:
+          RSS(ref_interp_create(&ref_interp, ref_grid, background),
+              "make interp");
+          RSS(ref_interp_locate(ref_interp), "locate");
+          ref_interp_free(ref_interp);
+          RSS(ref_grid_free(background), "background");
+          break;
+        case 8:
+          snprintf(filename, 1024, "ref-bench-%d-metric.solb", trial);
+          RSS(ref_gather_metric(ref_grid, filename), "gather metric");
+          if (ref_mpi_once(ref_mpi)) remove(filename);
+          break;
+      }
+      elapsed = subcommand_wall_time() - start;
+      RSS(ref_mpi_max(ref_mpi, &elapsed, &max_elapsed, REF_DBL_TYPE), "max");
+      RSS(stage_stopwatch_stop(ref_mpi, stages[stage]), "stopwatch");
+      if (ref_mpi_once(ref_mpi)) {
+        seconds[stage + REF_BENCH_STAGES * trial] = max_elapsed;
+        nodes[stage] = (REF_DBL)ref_node_n_global(ref_grid_node(ref_grid));
+      }
+    }
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+  RSS(stage_scope_set(NULL), "scope");
+
+  if (ref_mpi_once(ref_mpi)) {
+    REF_DBL mean, stddev;
+    FILE *file = NULL;
+    if (NULL != compare) RSS(bench_baseline(compare, stages, baseline), "base");
+    if (NULL != save) {
+      file = fopen(save, "w");
+      if (NULL == (void *)file) printf("unable to open %s\n", save);
+      RNS(file, "unable to open file");
+      fprintf(file, "{\n");
+    }
+    printf("\n%-14s %12s %12s %12s %12s", "stage", "mean (s)", "stddev (s)",
+           "min (s)", "nodes/s");
+    if (NULL != compare) printf(" %10s", "/baseline");
+    printf("\n");
+    for (stage = 0; stage < REF_BENCH_STAGES; stage++) {
+      REF_DBL fastest = seconds[stage];
+      if (fastest < 0.0) {
+        printf("%-14s %12s\n", stages[stage], "skipped");
+        continue;
+      }
+      mean = 0.0;
+      for (trial = 0; trial < trials; trial++) {
+        mean += seconds[stage + REF_BENCH_STAGES * trial];
+        fastest = MIN(fastest, seconds[stage + REF_BENCH_STAGES * trial]);
+      }
+      mean /= (REF_DBL)trials;
+      stddev = 0.0;
+      for (trial = 0; trial < trials; trial++)
+        stddev += pow(seconds[stage + REF_BENCH_STAGES * trial] - mean, 2);
+      stddev = sqrt(stddev / (REF_DBL)MAX(1, trials - 1));
+      printf("%-14s %12.6f %12.6f %12.6f %12.4e", stages[stage], mean, stddev,
+             fastest, (mean > 0.0 ? nodes[stage] / mean : 0.0));
+      if (NULL != compare) {
+        if (baseline[stage] > 0.0) {
+          printf(" %10.3f%s", mean / baseline[stage],
+                 (mean > 1.1 * baseline[stage]) ? " slower" : "");
+        } else {
+          printf(" %10s", "-");
+        }
+      }
+      printf("\n");
+      if (NULL != file)
+        fprintf(file,
+                "  \"%s\": {\"mean\": %.9e, \"stddev\": %.9e, \"min\": %.9e, "
+                "\"nodes\": %.0f}%s\n",
+                stages[stage], mean, stddev, fastest, nodes[stage],
+                (REF_BENCH_STAGES - 1 == stage) ? "" : ",");
+    }
+    if (NULL != file) {
+      fprintf(file, "}\n");
+      fclose(file);
+      printf("saved %s\n", save);
+    }
+  }
+
+  ref_free(nodes);
+  ref_free(seconds);
+  ref_dict_free(ref_dict_bcs);
+  return REF_SUCCESS;
+shutdown:
+  if (ref_mpi_once(ref_mpi)) bench_help(argv[0]);
+  return REF_FAILURE;
+}
+
+static REF_STATUS grow(REF_MPI ref_mpi, int argc, char *argv[]) {
+  char *out_file;
+  char *in_file;
+  char project[1000];
+  size_t end_of_string;
+  REF_GRID ref_grid = NULL;
+  const char *mesher = "tetgen";
+  const char *mesher_options = NULL;
+  REF_INT pos;
+
+  if (ref_mpi_para(ref_mpi)) {
+    RSS(REF_IMPLEMENT, "ref grow is not parallel");
+  }
+  if (argc < 4) goto shutdown;
+  in_file = argv[2];
+  out_file = argv[3];
+  end_of_string = MIN(1023, strlen(argv[2]));
+  if (7 > end_of_string ||
+      strncmp(&(argv[2][end_of_string - 6]), ".meshb", 6) != 0)
+    goto shutdown;
+  strncpy(project, argv[2], end_of_string - 6);
+  project[end_of_string - 6] = '\0';
+
+  printf("import %s\n", in_file);
+  RSS(ref_import_by_extension(&ref_grid, ref_mpi, in_file), "load surface");
+
+  RXS(ref_args_find(argc, argv, "--mesher", &pos), REF_NOT_FOUND, "arg search");
+  if (REF_EMPTY != pos && pos < argc - 1) {
+    mesher = argv[pos + 1];
+    if (ref_mpi_once(ref_mpi)) printf("--mesher %s requested\n", mesher);
+  }
+
+  RXS(ref_args_find(argc, argv, "--mesher-options", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos && pos < argc - 1) {
+    mesher_options = argv[pos + 1];
+    if (ref_mpi_once(ref_mpi))
+      printf("--mesher-options %s requested\n", mesher_options);
+  }
+
+  if (strncmp(mesher, "t", 1) == 0) {
+    if (ref_mpi_once(ref_mpi)) {
+      printf("fill volume with TetGen\n");
+      RSB(ref_geom_tetgen_volume(ref_grid, project, mesher_options),
+          "tetgen surface to volume",
+          { report_interections(ref_grid, project); });
+    }
+    RSS(stage_stopwatch_stop(ref_mpi, "tetgen volume"), "stopwatch");
+  } else if (strncmp(mesher, "a", 1) == 0) {
+    if (ref_mpi_once(ref_mpi)) {
+      printf("fill volume with AFLR3\n");
+      RSB(ref_geom_aflr_volume(ref_grid, project, mesher_options),
+          "aflr surface to volume",
+          { report_interections(ref_grid, project); });
+    }
+    RSS(stage_stopwatch_stop(ref_mpi, "aflr volume"), "stopwatch");
+  } else {
+    printf("mesher '%s' not implemented\n", mesher);
+    goto shutdown;
+  }
+
+  ref_grid_surf(ref_grid) = REF_FALSE; /* needed until vol mesher para */
+  RSS(ref_validation_boundary_face(ref_grid), "boundary-interior connectivity");
+  RSS(stage_stopwatch_stop(ref_grid_mpi(ref_grid), "boundary-volume check"),
+      "stopwatch");
+
+  RSS(ref_split_edge_geometry(ref_grid), "split geom");
+  RSS(stage_stopwatch_stop(ref_grid_mpi(ref_grid), "split geom"), "stopwatch");
+
+  RSS(ref_node_synchronize_globals(ref_grid_node(ref_grid)), "sync glob");
+
+  printf("export %s\n", out_file);
+  RSS(ref_export_by_extension(ref_grid, out_file), "vol export");
+
+  RSS(ref_validation_cell_volume(ref_grid), "vol");
+
+  RSS(ref_grid_free(ref_grid), "create");
+
+  return REF_SUCCESS;
+shutdown:
+  if (ref_mpi_once(ref_mpi)) grow_help(argv[0]);
+  return REF_FAILURE;
+}
+
+REF_FCN static REF_STATUS ref_grid_extrude_field(REF_GRID twod_grid,
+                                                 REF_INT ldim,
+                                                 REF_DBL *twod_field,
+                                                 REF_GRID extruded_grid,
+                                                 REF_DBL *extruded_field) {
+  REF_NODE ref_node;
+  REF_SEARCH ref_search = NULL;
+  REF_LIST touching = NULL;
+  REF_INT node, candidate, best, item, i;
+  REF_GLOB global, n_global;
+  REF_DBL dist, radius, best_dist, position[3];
+  REF_INT n_searched = 0;
+  REF_BOOL verbose = REF_FALSE;
+  n_global = ref_node_n_global(ref_grid_node(twod_grid));
+  ref_node = ref_grid_node(extruded_grid);
+  each_ref_node_valid_node(ref_node, node) {
+    position[0] = ref_node_xyz(ref_grid_node(extruded_grid), 0, node);
     position[1] = ref_node_xyz(ref_grid_node(extruded_grid), 2, node);
     position[2] = 0.0;
     radius = 100.0 * 1.0e-8 *
                  sqrt(position[0] * position[0] + position[1] * position[1] +
-                      position[2] + position[2]) +
+                      position[2] * position[2]) +
              MAX(0, position[1] * (1.0 - cos(ref_math_in_radians(1.0))));
-    RSS(ref_search_touching(ref_search, touching, position, radius),
-        "search tree");
-    best_dist = 1.0e+200;
+    /* ref_grid_extrude_twod offsets each plane by the twod global count */
     best = REF_EMPTY;
-    each_ref_list_item(touching, item) {
-      candidate = ref_list_value(touching, item);
-      dist = sqrt(pow(position[0] -
-                          ref_node_xyz(ref_grid_node(twod_grid), 0, candidate),
-                      2) +
-                  pow(position[1] -
-                          ref_node_xyz(ref_grid_node(twod_grid), 1, candidate),
-                      2) +
-                  pow(position[2] -
-                          ref_node_xyz(ref_grid_node(twod_grid), 2, candidate),
-                      2));
-      if (dist < best_dist) {
-        best_dist = dist;
+    if (0 < n_global) {
+      global = ref_node_global(ref_node, node) % n_global;
+      candidate = REF_EMPTY;
+      RXS(ref_node_local(ref_grid_node(twod_grid), global, &candidate),
+          REF_NOT_FOUND, "twod local");
+      if (REF_EMPTY != candidate &&
+          ABS(position[0] -
+              ref_node_xyz(ref_grid_node(twod_grid), 0, candidate)) <= radius &&
+          ABS(position[1] -
+              ref_node_xyz(ref_grid_node(twod_grid), 1, candidate)) <= radius)
         best = candidate;
+    }
+    if (REF_EMPTY == best) {
+      if (NULL == ref_search) {
+        RSS(ref_list_create(&touching), "touching list");
+        RSS(ref_search_create(&ref_search,
+                              ref_node_n(ref_grid_node(twod_grid))),
+            "create search");
+        each_ref_node_valid_node(ref_grid_node(twod_grid), candidate) {
+          RSS(ref_search_insert(
+                  ref_search, candidate,
+                  ref_node_xyz_ptr(ref_grid_node(twod_grid), candidate), 0.0),
+              "ins");
+        }
       }
+      n_searched++;
+      RSS(ref_search_touching(ref_search, touching, position, radius),
+          "search tree");
+      best_dist = 1.0e+200;
+      each_ref_list_item(touching, item) {
+        candidate = ref_list_value(touching, item);
+        dist = sqrt(
+            pow(position[0] -
+                    ref_node_xyz(ref_grid_node(twod_grid), 0, candidate),
+                2) +
+            pow(position[1] -
+                    ref_node_xyz(ref_grid_node(twod_grid), 1, candidate),
+                2) +
+            pow(position[2] -
+                    ref_node_xyz(ref_grid_node(twod_grid), 2, candidate),
+                2));
+        if (dist < best_dist) {
+          best_dist = dist;
+          best = candidate;
+        }
+      }
+      if (verbose)
+        printf("dist %e position %f %f %f\n", best_dist, position[0],
+               position[1], position[2]);
+      RSS(ref_list_erase(touching), "erase");
     }
-    if (verbose)
-      printf("dist %e position %f %f %f\n", best_dist, position[0], position[1],
-             position[2]);
     if (REF_EMPTY != best) {
       for (i = 0; i < ldim; i++) {
         extruded_field[i + ldim * node] = twod_field[i + ldim * best];
       }
     }
-    RSS(ref_list_erase(touching), "erase");
   }
-  ref_search_free(ref_search);
-  ref_list_free(touching);
+  if (verbose && 0 < n_searched)
+    printf("%d extruded nodes located by search\n", n_searched);
+  if (NULL != ref_search) ref_search_free(ref_search);
+  if (NULL != touching) ref_list_free(touching);
+  return REF_SUCCESS;
+}
+
+#define REF_INTERP_WEIGHTS_VERSION (2)
+#define REF_INTERP_WEIGHTS_FINGERPRINT (7)
+
+/* cell count and first and last valid node locations, rejects weights
+ * of a different mesh with the same node counts */
+static REF_STATUS interp_weights_fingerprint(REF_GRID ref_grid,
+                                             REF_DBL *fingerprint) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_CELL ref_cell = ref_grid_tet(ref_grid);
+  REF_INT node, first = REF_EMPTY, last = REF_EMPTY, i;
+  if (ref_grid_twod(ref_grid)) ref_cell = ref_grid_tri(ref_grid);
+  each_ref_node_valid_node(ref_node, node) {
+    if (REF_EMPTY == first) first = node;
+    last = node;
+  }
+  fingerprint[0] = (REF_DBL)ref_cell_n(ref_cell);
+  for (i = 0; i < 3; i++) {
+    fingerprint[1 + i] =
+        (REF_EMPTY == first) ? 0.0 : ref_node_xyz(ref_node, i, first);
+    fingerprint[4 + i] =
+        (REF_EMPTY == last) ? 0.0 : ref_node_xyz(ref_node, i, last);
+  }
+  return REF_SUCCESS;
+}
+
+static REF_STATUS interp_weights_extract(REF_INTERP ref_interp,
+                                         REF_INT **donor_nodes,
+                                         REF_DBL **bary) {
+  REF_GRID donor_grid = ref_interp_from_grid(ref_interp);
+  REF_NODE receipt_node = ref_grid_node(ref_interp_to_grid(ref_interp));
+  REF_CELL donor_cell = ref_grid_tet(donor_grid);
+  REF_INT nodes[REF_CELL_MAX_SIZE_PER];
+  REF_INT node, i;
+  if (ref_grid_twod(donor_grid)) donor_cell = ref_grid_tri(donor_grid);
+  ref_malloc_init(*donor_nodes, 4 * ref_node_max(receipt_node), REF_INT,
+                  REF_EMPTY);
+  ref_malloc_init(*bary, 4 * ref_node_max(receipt_node), REF_DBL, 0.0);
+  each_ref_node_valid_node(receipt_node, node) {
+    RAS(REF_EMPTY != ref_interp_cell(ref_interp, node),
+        "receptor node not located");
+    RSS(ref_cell_nodes(donor_cell, ref_interp_cell(ref_interp, node), nodes),
+        "donor cell");
+    for (i = 0; i < ref_cell_node_per(donor_cell); i++) {
+      (*donor_nodes)[i + 4 * node] = nodes[i];
+      (*bary)[i + 4 * node] = ref_interp_bary(ref_interp, i, node);
+    }
+  }
+  return REF_SUCCESS;
+}
+
+static REF_STATUS interp_weights_save(REF_GRID donor_grid,
+                                      REF_GRID receipt_grid,
+                                      REF_INT *donor_nodes, REF_DBL *bary,
+                                      const char *filename) {
+  FILE *file;
+  REF_INT header[2];
+  REF_GLOB n_global[2];
+  REF_DBL fingerprint[2 * REF_INTERP_WEIGHTS_FINGERPRINT];
+  size_t n;
+  RSS(interp_weights_fingerprint(donor_grid, fingerprint), "donor");
+  RSS(interp_weights_fingerprint(
+          receipt_grid, &(fingerprint[REF_INTERP_WEIGHTS_FINGERPRINT])),
+      "receptor");
+  header[0] = REF_INTERP_WEIGHTS_VERSION;
+  header[1] = ref_node_max(ref_grid_node(receipt_grid));
+  n_global[0] = ref_node_n_global(ref_grid_node(donor_grid));
+  n_global[1] = ref_node_n_global(ref_grid_node(receipt_grid));
+  n = 4 * (size_t)header[1];
+  file = fopen(filename, "w");
+  if (NULL == (void *)file) printf("unable to open %s\n", filename);
+  RNS(file, "unable to open file");
+  RAB(2 == fwrite(header, sizeof(REF_INT), 2, file), "header",
+      { fclose(file); });
+  RAB(2 == fwrite(n_global, sizeof(REF_GLOB), 2, file), "n global",
+      { fclose(file); });
+  RAB(2 * REF_INTERP_WEIGHTS_FINGERPRINT ==
+          fwrite(fingerprint, sizeof(REF_DBL),
+                 2 * REF_INTERP_WEIGHTS_FINGERPRINT, file),
+      "fingerprint", { fclose(file); });
+  RAB(n == fwrite(donor_nodes, sizeof(REF_INT), n, file), "donor nodes",
+      { fclose(file); });
+  RAB(n == fwrite(bary, sizeof(REF_DBL), n, file), "bary", { fclose(file); });
+  RAS(0 == fclose(file), "close weights");
+  return REF_SUCCESS;
+}
+
+static REF_STATUS interp_weights_load(REF_GRID donor_grid,
+                                      REF_GRID receipt_grid,
+                                      REF_INT **donor_nodes, REF_DBL **bary,
+                                      const char *filename) {
+  FILE *file;
+  REF_INT header[2];
+  REF_GLOB n_global[2];
+  REF_DBL expected[2 * REF_INTERP_WEIGHTS_FINGERPRINT];
+  REF_DBL fingerprint[2 * REF_INTERP_WEIGHTS_FINGERPRINT];
+  REF_INT i;
+  size_t n;
+  RSS(interp_weights_fingerprint(donor_grid, expected), "donor");
+  RSS(interp_weights_fingerprint(
+          receipt_grid, &(expected[REF_INTERP_WEIGHTS_FINGERPRINT])),
+      "receptor");
+  file = fopen(filename, "r");
+  if (NULL == (void *)file) printf("unable to open %s\n", filename);
+  RNS(file, "unable to open file");
+  RAB(2 == fread(header, sizeof(REF_INT), 2, file), "header",
+      { fclose(file); });
+  RAB(REF_INTERP_WEIGHTS_VERSION == header[0], "weights version",
+      { fclose(file); });
+  RAB(ref_node_max(ref_grid_node(receipt_grid)) == header[1],
+      "weights receptor max different than receptor mesh", { fclose(file); });
+  RAB(2 == fread(n_global, sizeof(REF_GLOB), 2, file), "n global",
+      { fclose(file); });
+  RAB(ref_node_n_global(ref_grid_node(donor_grid)) == n_global[0],
+      "weights donor nodes different than donor mesh", { fclose(file); });
+  RAB(ref_node_n_global(ref_grid_node(receipt_grid)) == n_global[1],
+      "weights receptor nodes different than receptor mesh",
+      { fclose(file); });
+  RAB(2 * REF_INTERP_WEIGHTS_FINGERPRINT ==
+          fread(fingerprint, sizeof(REF_DBL),
+                2 * REF_INTERP_WEIGHTS_FINGERPRINT, file),
+      "fingerprint", { fclose(file); });
+  for (i = 0; i < 2 * REF_INTERP_WEIGHTS_FINGERPRINT; i++) {
+    RAB(ABS(fingerprint[i] - expected[i]) <=
+            1.0e-12 * MAX(1.0, ABS(expected[i])),
+        "weights computed for different donor or receptor mesh",
+        { fclose(file); });
+  }
+  n = 4 * (size_t)header[1];
+  ref_malloc(*donor_nodes, n, REF_INT);
+  ref_malloc(*bary, n, REF_DBL);
+  RAB(n == fread(*donor_nodes, sizeof(REF_INT), n, file), "donor nodes", {
+    ref_free(*bary);
+    ref_free(*donor_nodes);
+    *bary = NULL;
+    *donor_nodes = NULL;
+    fclose(file);
+  });
+  RAB(n == fread(*bary, sizeof(REF_DBL), n, file), "bary", {
+    ref_free(*bary);
+    ref_free(*donor_nodes);
+    *bary = NULL;
+    *donor_nodes = NULL;
+    fclose(file);
+  });
+  fclose(file);
+  return REF_SUCCESS;
+}
+
+static REF_STATUS interp_weights_gather(REF_GRID receipt_grid,
+                                        REF_INT *donor_nodes, REF_DBL *bary,
+                                        REF_INT ldim, REF_DBL *donor_solution,
+                                        REF_DBL *receipt_solution) {
+  REF_NODE receipt_node = ref_grid_node(receipt_grid);
+  REF_INT node, i, j, donor;
+  /* each receptor node is independent, results do not depend on threads */
+#ifdef _OPENMP
+#pragma omp parallel for private(i, j, donor) schedule(static)
+#endif
+  for (node = 0; node < ref_node_max(receipt_node); node++) {
+    if (!ref_node_valid(receipt_node, node)) continue;
+    for (i = 0; i < ldim; i++) receipt_solution[i + ldim * node] = 0.0;
+    for (j = 0; j < 4; j++) {
+      donor = donor_nodes[j + 4 * node];
+      if (REF_EMPTY == donor) continue;
+      for (i = 0; i < ldim; i++)
+        receipt_solution[i + ldim * node] +=
+            bary[j + 4 * node] * donor_solution[i + ldim * donor];
+    }
+  }
+  return REF_SUCCESS;
+}
+
+static REF_STATUS series_filename(const char *pattern, REF_BOOL series,
+                                  REF_INT index, char *filename,
+                                  size_t length) {
+  const char *percent;
+  char *end;
+  long width = 0;
+  percent = strchr(pattern, '%');
+  if (!series || NULL == percent) {
+    RAS(strlen(pattern) < length, "filename too long");
+    snprintf(filename, length, "%s", pattern);
+    return REF_SUCCESS;
+  }
+  width = strtol(percent + 1, &end, 10);
+  RAS('d' == *end, "series pattern expects %d or %0<width>d");
+  RAS(NULL == strchr(end, '%'), "series pattern has more than one %");
+  RAS(strlen(pattern) + (size_t)MAX(width, 10) < length, "filename too long");
+  snprintf(filename, length, "%.*s%0*d%s", (int)(percent - pattern), pattern,
+           (int)width, index, end + 1);
+  return REF_SUCCESS;
+}
+
+/* extruded_grid is NULL or the receptor extruded once for every write */
+static REF_STATUS interpolate_write(REF_GRID receipt_grid,
+                                    REF_GRID extruded_grid, REF_INT ldim,
+                                    REF_DBL *receipt_solution,
+                                    const char *receipt_solb) {
+  REF_MPI ref_mpi = ref_grid_mpi(receipt_grid);
+  if (NULL != extruded_grid) {
+    REF_DBL *extruded_solution = NULL;
+    if (ref_mpi_once(ref_mpi)) printf("extrude receptor solution\n");
+    ref_malloc(extruded_solution,
+               ldim * ref_node_max(ref_grid_node(extruded_grid)), REF_DBL);
+    RSS(ref_grid_extrude_field(receipt_grid, ldim, receipt_solution,
+                               extruded_grid, extruded_solution),
+        "extrude solution");
+    if (ref_mpi_once(ref_mpi))
+      printf("writing interpolated extruded solution %s\n", receipt_solb);
+    RSS(ref_gather_scalar_by_extension(extruded_grid, ldim, extruded_solution,
+                                       NULL, receipt_solb),
+        "gather recept");
+    ref_free(extruded_solution);
+    RSS(stage_stopwatch_stop(ref_mpi, "gather extruded receptor"),
+        "stopwatch");
+  } else {
+    if (ref_mpi_once(ref_mpi))
+      printf("writing receptor solution %s\n", receipt_solb);
+    RSS(ref_gather_scalar_by_extension(receipt_grid, ldim, receipt_solution,
+                                       NULL, receipt_solb),
+        "gather recept");
+    RSS(stage_stopwatch_stop(ref_mpi, "gather receptor"), "stopwatch");
+  }
   return REF_SUCCESS;
 }
 
@@ -2300,13 +3764,24 @@ static REF_STATUS interpolate(REF_MPI ref_mpi, int argc, char *argv[]) {
   char *donor_solb;
   char *donor_meshb;
   char *persist_solb;
+  char donor_filename[1024];
+  char receipt_filename[1024];
   REF_GRID donor_grid = NULL;
   REF_GRID receipt_grid = NULL;
-  REF_INT ldim, persist_ldim;
+  REF_GRID extruded_grid = NULL;
+  REF_INT ldim, persist_ldim, series_ldim;
   REF_DBL *donor_solution, *receipt_solution;
-  REF_INTERP ref_interp;
+  REF_INTERP ref_interp = NULL;
   REF_INT pos;
   REF_INT faceid;
+  const char *save_weights = NULL;
+  const char *load_weights = NULL;
+  REF_INT *donor_nodes = NULL;
+  REF_DBL *bary = NULL;
+  REF_BOOL extrude = REF_FALSE;
+  REF_BOOL series = REF_FALSE;
+  REF_BOOL extract = REF_FALSE;
+  REF_INT first = 0, last = 0, increment = 1, index;
 
   if (argc < 6) goto shutdown;
   donor_meshb = argv[2];
@@ -2314,39 +3789,100 @@ static REF_STATUS interpolate(REF_MPI ref_mpi, int argc, char *argv[]) {
   receipt_meshb = argv[4];
   receipt_solb = argv[5];
 
-  ref_mpi_stopwatch_start(ref_mpi);
+  RXS(ref_args_find(argc, argv, "--save-weights", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    if (pos >= argc - 1) {
+      if (ref_mpi_once(ref_mpi))
+        printf("--save-weights requires a filename\n");
+      goto shutdown;
+    }
+    save_weights = argv[pos + 1];
+  }
+  RXS(ref_args_find(argc, argv, "--load-weights", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    if (pos >= argc - 1) {
+      if (ref_mpi_once(ref_mpi))
+        printf("--load-weights requires a filename\n");
+      goto shutdown;
+    }
+    load_weights = argv[pos + 1];
+  }
+  if ((NULL != save_weights || NULL != load_weights) &&
+      ref_mpi_para(ref_mpi)) {
+    RSS(REF_IMPLEMENT, "interpolation weights are not parallel");
+  }
+
+  RXS(ref_args_find(argc, argv, "--series", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    if (pos >= argc - 2) {
+      if (ref_mpi_once(ref_mpi))
+        printf("--series requires <first> <last> [<increment>]\n");
+      goto shutdown;
+    }
+    series = REF_TRUE;
+    first = atoi(argv[pos + 1]);
+    last = atoi(argv[pos + 2]);
+    if (pos < argc - 3 && '-' != argv[pos + 3][0])
+      increment = atoi(argv[pos + 3]);
+    if (increment < 1 || last < first) {
+      if (ref_mpi_once(ref_mpi))
+        printf("--series requires first <= last and increment > 0\n");
+      goto shutdown;
+    }
+    if (NULL == strchr(donor_solb, '%') || NULL == strchr(receipt_solb, '%')) {
+      if (ref_mpi_once(ref_mpi))
+        printf("--series requires %%d in donor and receptor solb names\n");
+      goto shutdown;
+    }
+  }
+
+  RXS(ref_args_find(argc, argv, "--extrude", &pos), REF_NOT_FOUND,
+      "arg search");
+  extrude = (REF_EMPTY != pos);
+
+  RSS(stage_stopwatch_start(ref_mpi), "stopwatch");
 
   if (ref_mpi_para(ref_mpi)) {
     if (ref_mpi_once(ref_mpi)) printf("part %s\n", donor_meshb);
     RSS(ref_part_by_extension(&donor_grid, ref_mpi, donor_meshb), "part");
-    ref_mpi_stopwatch_stop(ref_mpi, "donor part");
+    RSS(stage_stopwatch_stop(ref_mpi, "donor part"), "stopwatch");
   } else {
     if (ref_mpi_once(ref_mpi)) printf("import %s\n", donor_meshb);
     RSS(ref_import_by_extension(&donor_grid, ref_mpi, donor_meshb), "import");
-    ref_mpi_stopwatch_stop(ref_mpi, "donor import");
+    RSS(stage_stopwatch_stop(ref_mpi, "donor import"), "stopwatch");
   }
   if (ref_mpi_once(ref_mpi))
     printf("  read " REF_GLOB_FMT " vertices\n",
            ref_node_n_global(ref_grid_node(donor_grid)));
 
-  if (ref_mpi_once(ref_mpi)) printf("part solution %s\n", donor_solb);
-  RSS(ref_part_scalar(donor_grid, &ldim, &donor_solution, donor_solb),
+  RSS(series_filename(donor_solb, series, first, donor_filename, 1024),
+      "donor name");
+  if (ref_mpi_once(ref_mpi)) printf("part solution %s\n", donor_filename);
+  RSS(ref_part_scalar(donor_grid, &ldim, &donor_solution, donor_filename),
       "part solution");
-  ref_mpi_stopwatch_stop(ref_mpi, "donor part solution");
+  RSS(stage_stopwatch_stop(ref_mpi, "donor part solution"), "stopwatch");
 
   if (ref_mpi_para(ref_mpi)) {
     if (ref_mpi_once(ref_mpi)) printf("part %s\n", receipt_meshb);
     RSS(ref_part_by_extension(&receipt_grid, ref_mpi, receipt_meshb), "part");
-    ref_mpi_stopwatch_stop(ref_mpi, "receptor part");
+    RSS(stage_stopwatch_stop(ref_mpi, "receptor part"), "stopwatch");
   } else {
     if (ref_mpi_once(ref_mpi)) printf("import %s\n", receipt_meshb);
     RSS(ref_import_by_extension(&receipt_grid, ref_mpi, receipt_meshb),
         "import");
-    ref_mpi_stopwatch_stop(ref_mpi, "receptor import");
+    RSS(stage_stopwatch_stop(ref_mpi, "receptor import"), "stopwatch");
   }
   if (ref_mpi_once(ref_mpi))
     printf("  read " REF_GLOB_FMT " vertices\n",
            ref_node_n_global(ref_grid_node(receipt_grid)));
+  if (extrude) {
+    if (ref_mpi_once(ref_mpi)) printf("extrude receptor\n");
+    RSS(ref_grid_extrude_twod(&extruded_grid, receipt_grid, 2), "extrude");
+    RSS(stage_stopwatch_stop(ref_mpi, "extrude receptor"), "stopwatch");
+  }
 
   if (ref_mpi_once(ref_mpi)) {
     printf("%d leading dim from " REF_GLOB_FMT " donor nodes to " REF_GLOB_FMT
@@ -2357,6 +3893,9 @@ static REF_STATUS interpolate(REF_MPI ref_mpi, int argc, char *argv[]) {
 
   RXS(ref_args_find(argc, argv, "--face", &pos), REF_NOT_FOUND, "arg search");
   if (REF_EMPTY != pos && pos < argc - 2) {
+    RAS(!series, "--face does not support --series");
+    RAS(NULL == save_weights && NULL == load_weights,
+        "--face does not support --save-weights or --load-weights");
     faceid = atoi(argv[pos + 1]);
     persist_solb = argv[pos + 2];
     if (ref_mpi_once(ref_mpi))
@@ -2364,7 +3903,7 @@ static REF_STATUS interpolate(REF_MPI ref_mpi, int argc, char *argv[]) {
     RSS(ref_part_scalar(receipt_grid, &persist_ldim, &receipt_solution,
                         persist_solb),
         "part solution");
-    ref_mpi_stopwatch_stop(ref_mpi, "persist part solution");
+    RSS(stage_stopwatch_stop(ref_mpi, "persist part solution"), "stopwatch");
     REIS(ldim, persist_ldim, "persist leading dimension different than donor");
 
     if (ref_mpi_once(ref_mpi)) printf("update solution on faceid %d\n", faceid);
@@ -2373,59 +3912,141 @@ static REF_STATUS interpolate(REF_MPI ref_mpi, int argc, char *argv[]) {
     RSS(ref_interp_face_only(ref_interp, faceid, ldim, donor_solution,
                              receipt_solution),
         "map");
-    ref_mpi_stopwatch_stop(ref_mpi, "update");
+    RSS(stage_stopwatch_stop(ref_mpi, "update"), "stopwatch");
+    RSS(series_filename(receipt_solb, series, first, receipt_filename,
+                        1024),
+        "receptor name");
+    RSS(interpolate_write(receipt_grid, extruded_grid, ldim, receipt_solution,
+                          receipt_filename),
+        "write receptor");
+    ref_free(receipt_solution);
+    ref_free(donor_solution);
   } else {
-    if (ref_mpi_once(ref_mpi)) printf("locate receptor nodes\n");
-    RSS(ref_interp_create(&ref_interp, donor_grid, receipt_grid),
-        "make interp");
-    RSS(ref_interp_locate(ref_interp), "map");
-    ref_mpi_stopwatch_stop(ref_mpi, "locate");
-    if (ref_mpi_once(ref_mpi)) printf("interpolate receptor nodes\n");
-    ref_malloc(receipt_solution,
-               ldim * ref_node_max(ref_grid_node(receipt_grid)), REF_DBL);
-    RSS(ref_interp_scalar(ref_interp, ldim, donor_solution, receipt_solution),
-        "interp scalar");
-    ref_mpi_stopwatch_stop(ref_mpi, "interp");
-  }
-
-  RXS(ref_args_find(argc, argv, "--extrude", &pos), REF_NOT_FOUND,
-      "arg search");
-  if (REF_EMPTY != pos) {
-    REF_GRID extruded_grid;
-    REF_DBL *extruded_solution = NULL;
-    if (ref_mpi_once(ref_mpi)) printf("extrude receptor solution\n");
-    RSS(ref_grid_extrude_twod(&extruded_grid, receipt_grid, 2), "extrude");
-    ref_malloc(extruded_solution,
-               ldim * ref_node_max(ref_grid_node(extruded_grid)), REF_DBL);
-    RSS(ref_grid_extrude_field(receipt_grid, ldim, receipt_solution,
-                               extruded_grid, extruded_solution),
-        "extrude solution");
-    if (ref_mpi_once(ref_mpi))
-      printf("writing interpolated extruded solution %s\n", receipt_solb);
-    RSS(ref_gather_scalar_by_extension(extruded_grid, ldim, extruded_solution,
-                                       NULL, receipt_solb),
-        "gather recept");
-    ref_free(extruded_solution);
-    RSS(ref_grid_free(extruded_grid), "free");
-  } else {
-    if (ref_mpi_once(ref_mpi))
-      printf("writing receptor solution %s\n", receipt_solb);
-    RSS(ref_gather_scalar_by_extension(receipt_grid, ldim, receipt_solution,
-                                       NULL, receipt_solb),
-        "gather recept");
-    ref_mpi_stopwatch_stop(ref_mpi, "gather receptor");
-  }
-
-  ref_free(receipt_solution);
-  ref_interp_free(ref_interp);
+    if (NULL != load_weights) {
+      if (ref_mpi_once(ref_mpi)) printf("load weights %s\n", load_weights);
+      RSS(interp_weights_load(donor_grid, receipt_grid, &donor_nodes, &bary,
+                              load_weights),
+          "load weights");
+      RSS(stage_stopwatch_stop(ref_mpi, "load weights"), "stopwatch");
+    } else {
+      if (ref_mpi_once(ref_mpi)) printf("locate receptor nodes\n");
+      RSS(ref_interp_create(&ref_interp, donor_grid, receipt_grid),
+          "make interp");
+      RSS(ref_interp_locate(ref_interp), "map");
+      RSS(stage_stopwatch_stop(ref_mpi, "locate"), "stopwatch");
+      /* weights pay off when saved, reused across a series, or threaded */
+      extract = (NULL != save_weights || series);
+#ifdef _OPENMP
+      if (omp_get_max_threads() > 1) extract = REF_TRUE;
+#endif
+      if (!ref_mpi_para(ref_mpi) && extract) {
+        RSS(interp_weights_extract(ref_interp, &donor_nodes, &bary),
+            "extract weights");
+        RSS(stage_stopwatch_stop(ref_mpi, "extract weights"), "stopwatch");
+      }
+      if (NULL != save_weights) {
+        if (ref_mpi_once(ref_mpi)) printf("save weights %s\n", save_weights);
+        RSS(interp_weights_save(donor_grid, receipt_grid, donor_nodes, bary,
+                                save_weights),
+            "save weights");
+        RSS(stage_stopwatch_stop(ref_mpi, "save weights"), "stopwatch");
+      }
+    }
+    for (index = first; index <= last; index += increment) {
+      if (index != first) {
+        RSS(series_filename(donor_solb, series, index, donor_filename,
+                            1024),
+            "donor name");
+        if (ref_mpi_once(ref_mpi)) printf("part solution %s\n", donor_filename);
+        RSS(ref_part_scalar(donor_grid, &series_ldim, &donor_solution,
+                            donor_filename),
+            "part solution");
+        RSS(stage_stopwatch_stop(ref_mpi, "donor part solution"), "stopwatch");
+        REIS(ldim, series_ldim, "series leading dimension changed");
+      }
+      if (ref_mpi_once(ref_mpi)) printf("interpolate receptor nodes\n");
+      ref_malloc(receipt_solution,
+                 ldim * ref_node_max(ref_grid_node(receipt_grid)), REF_DBL);
+      if (NULL != donor_nodes) {
+        RSS(interp_weights_gather(receipt_grid, donor_nodes, bary, ldim,
+                                  donor_solution, receipt_solution),
+            "gather weights");
+      } else {
+        RSS(ref_interp_scalar(ref_interp, ldim, donor_solution,
+                              receipt_solution),
+            "interp scalar");
+      }
+      RSS(stage_stopwatch_stop(ref_mpi, "interp"), "stopwatch");
+      RSS(series_filename(receipt_solb, series, index, receipt_filename,
+                          1024),
+          "receptor name");
+      RSS(interpolate_write(receipt_grid, extruded_grid, ldim,
+                            receipt_solution, receipt_filename),
+          "write receptor");
+      ref_free(receipt_solution);
+      ref_free(donor_solution);
+    }
+    ref_free(bary);
+    ref_free(donor_nodes);
+  }
+
+  if (NULL != ref_interp) ref_interp_free(ref_interp);
+  if (NULL != extruded_grid) RSS(ref_grid_free(extruded_grid), "extruded");
   RSS(ref_grid_free(receipt_grid), "receipt");
-  ref_free(donor_solution);
   RSS(ref_grid_free(donor_grid), "donor");
 
   return REF_SUCCESS;
-shutdown:
-  if (ref_mpi_once(ref_mpi)) interpolate_help(argv[0]);
-  return REF_FAILURE;
+shutdown:
+  if (ref_mpi_once(ref_mpi)) interpolate_help(argv[0]);
+  return REF_FAILURE;
+}
+
+typedef enum REF_INTERPOLANT_TYPES {
+  REF_INTERPOLANT_MACH,
+  REF_INTERPOLANT_HTOT,
+  REF_INTERPOLANT_PTOT,
+  REF_INTERPOLANT_PRESSURE,
+  REF_INTERPOLANT_DENSITY,
+  REF_INTERPOLANT_TEMPERATURE,
+  REF_INTERPOLANT_INCOMP,
+  REF_INTERPOLANT_SPACE_TIME,
+  REF_INTERPOLANT_FILE
+} REF_INTERPOLANT_TYPE;
+
+static REF_STATUS interpolant_type(const char *interpolant,
+                                   REF_INTERPOLANT_TYPE *type) {
+  *type = REF_INTERPOLANT_FILE;
+  if (0 == strcmp(interpolant, "mach")) *type = REF_INTERPOLANT_MACH;
+  if (0 == strcmp(interpolant, "htot")) *type = REF_INTERPOLANT_HTOT;
+  if (0 == strcmp(interpolant, "ptot")) *type = REF_INTERPOLANT_PTOT;
+  if (0 == strcmp(interpolant, "pressure")) *type = REF_INTERPOLANT_PRESSURE;
+  if (0 == strcmp(interpolant, "density")) *type = REF_INTERPOLANT_DENSITY;
+  if (0 == strcmp(interpolant, "temperature"))
+    *type = REF_INTERPOLANT_TEMPERATURE;
+  if (0 == strcmp(interpolant, "incomp")) *type = REF_INTERPOLANT_INCOMP;
+  if (0 == strcmp(interpolant, "space-time"))
+    *type = REF_INTERPOLANT_SPACE_TIME;
+  return REF_SUCCESS;
+}
+
+static REF_STATUS interpolant_from_file(REF_GRID ref_grid,
+                                        const char *interpolant,
+                                        REF_DBL *scalar) {
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_INT node;
+  REF_INT solb_ldim;
+  REF_DBL *solb_scalar;
+  if (ref_mpi_once(ref_mpi))
+    printf("opening %s as multiscale interpolant\n", interpolant);
+  RSS(ref_part_scalar(ref_grid, &solb_ldim, &solb_scalar, interpolant),
+      "unable to load interpolant scalar");
+  REIS(1, solb_ldim, "expected one interpolant scalar");
+  each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
+    scalar[node] = solb_scalar[node];
+  }
+  ref_free(solb_scalar);
+  RSS(stage_stopwatch_stop(ref_mpi, "read interpolant from file"), "stopwatch");
+  return REF_SUCCESS;
 }
 
 static REF_STATUS locichem_field_scalar(REF_GRID ref_grid, REF_INT ldim,
@@ -2434,7 +4055,7 @@ static REF_STATUS locichem_field_scalar(REF_GRID ref_grid, REF_INT ldim,
                                         REF_DBL *scalar) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_INT node;
-  REF_BOOL recognized = REF_FALSE;
+  REF_INTERPOLANT_TYPE type;
   REF_BOOL debug = REF_FALSE;
 
   if (debug)
@@ -2444,39 +4065,248 @@ static REF_STATUS locichem_field_scalar(REF_GRID ref_grid, REF_INT ldim,
 
   RSS(ref_validation_finite(ref_grid, ldim, initial_field), "init field");
   if (ref_mpi_once(ref_mpi)) printf("extract %s\n", interpolant);
-  if (0 == strcmp(interpolant, "mach")) {
-    recognized = REF_TRUE;
-    each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
-      scalar[node] = initial_field[2 + ldim * node];
+  RSS(interpolant_type(interpolant, &type), "interpolant type");
+  switch (type) {
+    case REF_INTERPOLANT_MACH:
+      each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
+        scalar[node] = initial_field[2 + ldim * node];
+      }
+      RSS(stage_stopwatch_stop(ref_mpi, "extract scalar"), "stopwatch");
+      break;
+    case REF_INTERPOLANT_TEMPERATURE:
+      each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
+        scalar[node] = initial_field[5 + ldim * node];
+      }
+      RSS(stage_stopwatch_stop(ref_mpi, "extract scalar"), "stopwatch");
+      break;
+    default:
+      RSS(interpolant_from_file(ref_grid, interpolant, scalar), "from file");
+  }
+
+  if (debug)
+    RSS(ref_gather_scalar_by_extension(ref_grid, 1, scalar, NULL,
+                                       "loci-scalar.plt"),
+        "scalar");
+
+  return REF_SUCCESS;
+}
+
+/* press and temp are derived from each other when only one is stored */
+static REF_STATUS compressible_state(REF_DBL *field, REF_INT ldim, REF_INT node,
+                                     REF_INT rho_index, REF_INT w_index,
+                                     REF_INT temp_index, REF_INT press_index,
+                                     REF_DBL gamma, REF_DBL *press,
+                                     REF_DBL *temp, REF_DBL *u2) {
+  REF_DBL rho, u, v, w;
+  rho = field[rho_index + ldim * node];
+  u = field[rho_index + 1 + ldim * node];
+  v = field[rho_index + 2 + ldim * node];
+  w = 0.0;
+  if (REF_EMPTY != w_index) w = field[w_index + ldim * node];
+  if (REF_EMPTY != temp_index) {
+    *temp = field[temp_index + ldim * node];
+    *press = rho * (*temp) / gamma;
+  } else {
+    *press = field[press_index + ldim * node];
+    RAB(ref_math_divisible(*press, rho), "can not divide by rho", {
+      printf("rho = %e  u = %e  v = %e  w = %e  press = %e\n", rho, u, v, w,
+             *press);
+    });
+    *temp = gamma * (*press / rho);
+  }
+  *u2 = u * u + v * v + w * w;
+  return REF_SUCCESS;
+}
+
+static REF_STATUS compressible_mach2(REF_DBL u2, REF_DBL temp,
+                                     REF_DBL *mach2) {
+  RAB(ref_math_divisible(u2, temp), "can not divide by temp",
+      { printf("u2 = %e  temp = %e\n", u2, temp); });
+  *mach2 = u2 / temp;
+  RAB(*mach2 >= 0, "negative mach2",
+      { printf("u2 = %e  temp = %e\n", u2, temp); });
+  return REF_SUCCESS;
+}
+
+/* the per-node kernels flag failures and report after the threaded loop */
+static REF_STATUS compressible_mach(REF_NODE ref_node, REF_INT ldim,
+                                    REF_DBL *field, REF_INT rho_index,
+                                    REF_INT w_index, REF_INT temp_index,
+                                    REF_INT press_index, REF_DBL gamma,
+                                    REF_DBL *scalar) {
+  REF_STATUS status = REF_SUCCESS;
+  REF_INT node;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (node = 0; node < ref_node_max(ref_node); node++) {
+    REF_DBL press, temp, u2, mach2;
+    if (!ref_node_valid(ref_node, node)) continue;
+    if (REF_SUCCESS != compressible_state(field, ldim, node, rho_index,
+                                          w_index, temp_index, press_index,
+                                          gamma, &press, &temp, &u2) ||
+        REF_SUCCESS != compressible_mach2(u2, temp, &mach2)) {
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+      status = REF_FAILURE;
+      continue;
     }
+    scalar[node] = sqrt(mach2);
   }
-  if (0 == strcmp(interpolant, "temperature")) {
-    recognized = REF_TRUE;
-    each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
-      scalar[node] = initial_field[5 + ldim * node];
+  RSS(status, "mach");
+  return REF_SUCCESS;
+}
+
+static REF_STATUS compressible_htot(REF_NODE ref_node, REF_INT ldim,
+                                    REF_DBL *field, REF_INT rho_index,
+                                    REF_INT w_index, REF_INT temp_index,
+                                    REF_INT press_index, REF_DBL gamma,
+                                    REF_DBL *scalar) {
+  REF_STATUS status = REF_SUCCESS;
+  REF_INT node;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (node = 0; node < ref_node_max(ref_node); node++) {
+    REF_DBL press, temp, u2;
+    if (!ref_node_valid(ref_node, node)) continue;
+    if (REF_SUCCESS != compressible_state(field, ldim, node, rho_index,
+                                          w_index, temp_index, press_index,
+                                          gamma, &press, &temp, &u2)) {
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+      status = REF_FAILURE;
+      continue;
     }
+    scalar[node] = temp * (1.0 / (gamma - 1.0)) + 0.5 * u2;
   }
-  if (recognized) ref_mpi_stopwatch_stop(ref_mpi, "extract scalar");
+  RSS(status, "htot");
+  return REF_SUCCESS;
+}
 
-  if (!recognized) {
-    REF_INT solb_ldim;
-    REF_DBL *solb_scalar;
-    if (ref_mpi_once(ref_mpi))
-      printf("opening %s as multiscale interpolant\n", interpolant);
-    RSS(ref_part_scalar(ref_grid, &solb_ldim, &solb_scalar, interpolant),
-        "unable to load interpolant scalar");
-    REIS(1, solb_ldim, "expected one interpolant scalar");
-    each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
-      scalar[node] = solb_scalar[node];
+static REF_STATUS compressible_ptot(REF_NODE ref_node, REF_INT ldim,
+                                    REF_DBL *field, REF_INT rho_index,
+                                    REF_INT w_index, REF_INT temp_index,
+                                    REF_INT press_index, REF_DBL gamma,
+                                    REF_DBL *scalar) {
+  REF_STATUS status = REF_SUCCESS;
+  REF_INT node;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (node = 0; node < ref_node_max(ref_node); node++) {
+    REF_DBL press, temp, u2, mach2;
+    if (!ref_node_valid(ref_node, node)) continue;
+    if (REF_SUCCESS != compressible_state(field, ldim, node, rho_index,
+                                          w_index, temp_index, press_index,
+                                          gamma, &press, &temp, &u2) ||
+        REF_SUCCESS != compressible_mach2(u2, temp, &mach2)) {
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+      status = REF_FAILURE;
+      continue;
     }
-    ref_free(solb_scalar);
-    ref_mpi_stopwatch_stop(ref_mpi, "read interpolant from file");
+    scalar[node] =
+        press * pow(1.0 + 0.5 * (gamma - 1.0) * mach2, gamma / (gamma - 1));
   }
+  RSS(status, "ptot");
+  return REF_SUCCESS;
+}
 
-  if (debug)
-    RSS(ref_gather_scalar_by_extension(ref_grid, 1, scalar, NULL,
-                                       "loci-scalar.plt"),
-        "scalar");
+/* copy a stored quantity, the strided reads have no checks to flag */
+static REF_STATUS compressible_copy(REF_NODE ref_node, REF_INT ldim,
+                                    REF_DBL *field, REF_INT index,
+                                    REF_DBL *scalar) {
+  REF_INT node;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (node = 0; node < ref_node_max(ref_node); node++) {
+    if (!ref_node_valid(ref_node, node)) continue;
+    scalar[node] = field[index + ldim * node];
+  }
+  return REF_SUCCESS;
+}
+
+/* rho, u, v, w, press, temp, u2 are computed only as needed by type */
+static REF_STATUS compressible_scalar(REF_GRID ref_grid, REF_INT ldim,
+                                      REF_DBL *field, REF_INT rho_index,
+                                      REF_INT w_index, REF_INT temp_index,
+                                      REF_INT press_index,
+                                      REF_INTERPOLANT_TYPE type,
+                                      REF_DBL *scalar) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_STATUS status = REF_SUCCESS;
+  REF_INT node;
+  REF_DBL gamma = 1.4;
+
+  switch (type) {
+    case REF_INTERPOLANT_DENSITY:
+      RSS(compressible_copy(ref_node, ldim, field, rho_index, scalar),
+          "density");
+      break;
+    case REF_INTERPOLANT_PRESSURE:
+      if (REF_EMPTY != press_index) {
+        RSS(compressible_copy(ref_node, ldim, field, press_index, scalar),
+            "pressure");
+      } else {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (node = 0; node < ref_node_max(ref_node); node++) {
+          if (!ref_node_valid(ref_node, node)) continue;
+          scalar[node] = field[rho_index + ldim * node] *
+                         field[temp_index + ldim * node] / gamma;
+        }
+      }
+      break;
+    case REF_INTERPOLANT_TEMPERATURE:
+      if (REF_EMPTY != temp_index) {
+        RSS(compressible_copy(ref_node, ldim, field, temp_index, scalar),
+            "temperature");
+      } else {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (node = 0; node < ref_node_max(ref_node); node++) {
+          REF_DBL rho, press;
+          if (!ref_node_valid(ref_node, node)) continue;
+          rho = field[rho_index + ldim * node];
+          press = field[press_index + ldim * node];
+          if (!ref_math_divisible(press, rho)) {
+            printf("rho = %e  press = %e\n", rho, press);
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+            status = REF_FAILURE;
+            continue;
+          }
+          scalar[node] = gamma * (press / rho);
+        }
+        RSS(status, "can not divide by rho");
+      }
+      break;
+    case REF_INTERPOLANT_MACH:
+      RSS(compressible_mach(ref_node, ldim, field, rho_index, w_index,
+                            temp_index, press_index, gamma, scalar),
+          "mach");
+      break;
+    case REF_INTERPOLANT_HTOT:
+      RSS(compressible_htot(ref_node, ldim, field, rho_index, w_index,
+                            temp_index, press_index, gamma, scalar),
+          "htot");
+      break;
+    case REF_INTERPOLANT_PTOT:
+      RSS(compressible_ptot(ref_node, ldim, field, rho_index, w_index,
+                            temp_index, press_index, gamma, scalar),
+          "ptot");
+      break;
+    default:
+      RSS(REF_IMPLEMENT, "not a compressible interpolant");
+  }
 
   return REF_SUCCESS;
 }
@@ -2485,83 +4315,35 @@ static REF_STATUS avm_field_scalar(REF_GRID ref_grid, REF_INT ldim,
                                    REF_DBL *initial_field,
                                    const char *interpolant, REF_DBL *scalar) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
-  REF_INT node;
-  REF_DBL gamma = 1.4;
-  REF_BOOL recognized = REF_FALSE;
+  REF_INTERPOLANT_TYPE type;
 
   RSS(ref_validation_finite(ref_grid, ldim, initial_field), "init field");
   if (ref_mpi_once(ref_mpi)) printf("compute %s\n", interpolant);
-  if ((strcmp(interpolant, "mach") == 0) ||
-      (strcmp(interpolant, "htot") == 0) ||
-      (strcmp(interpolant, "ptot") == 0) ||
-      (strcmp(interpolant, "pressure") == 0) ||
-      (strcmp(interpolant, "density") == 0) ||
-      (strcmp(interpolant, "temperature") == 0)) {
-    RAS(5 <= ldim, "expected 5 or more variables per vertex for compressible");
-    each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
-      REF_DBL rho, u, v, w, press, temp, u2, mach2;
+  RSS(interpolant_type(interpolant, &type), "interpolant type");
+  switch (type) {
+    case REF_INTERPOLANT_MACH:
+    case REF_INTERPOLANT_HTOT:
+    case REF_INTERPOLANT_PTOT:
+    case REF_INTERPOLANT_PRESSURE:
+    case REF_INTERPOLANT_DENSITY:
+    case REF_INTERPOLANT_TEMPERATURE:
+      RAS(5 <= ldim,
+          "expected 5 or more variables per vertex for compressible");
+      /* [rho,u,v,temp] in twod, [rho,u,v,w,temp] in threed */
       if (ref_grid_twod(ref_grid)) {
-        rho = initial_field[0 + ldim * node];
-        u = initial_field[1 + ldim * node];
-        v = initial_field[2 + ldim * node];
-        w = 0.0;
-        temp = initial_field[3 + ldim * node];
+        RSS(compressible_scalar(ref_grid, ldim, initial_field, 0, REF_EMPTY, 3,
+                                REF_EMPTY, type, scalar),
+            "twod compressible");
       } else {
-        rho = initial_field[0 + ldim * node];
-        u = initial_field[1 + ldim * node];
-        v = initial_field[2 + ldim * node];
-        w = initial_field[3 + ldim * node];
-        temp = initial_field[4 + ldim * node];
-      }
-      press = rho * temp / gamma;
-      u2 = u * u + v * v + w * w;
-      RAB(ref_math_divisible(u2, temp), "can not divide by temp", {
-        printf("rho = %e  u = %e  v = %e  w = %e  press = %e  temp = %e\n", rho,
-               u, v, w, press, temp);
-      });
-      mach2 = u2 / temp;
-      RAB(mach2 >= 0, "negative mach2", {
-        printf("rho = %e  u = %e  v = %e  w = %e  press = %e  temp = %e\n", rho,
-               u, v, w, press, temp);
-      });
-      if (strcmp(interpolant, "mach") == 0) {
-        recognized = REF_TRUE;
-        scalar[node] = sqrt(mach2);
-      } else if (strcmp(interpolant, "htot") == 0) {
-        recognized = REF_TRUE;
-        scalar[node] = temp * (1.0 / (gamma - 1.0)) + 0.5 * u2;
-      } else if (strcmp(interpolant, "ptot") == 0) {
-        recognized = REF_TRUE;
-        scalar[node] =
-            press * pow(1.0 + 0.5 * (gamma - 1.0) * mach2, gamma / (gamma - 1));
-      } else if (strcmp(interpolant, "pressure") == 0) {
-        recognized = REF_TRUE;
-        scalar[node] = press;
-      } else if (strcmp(interpolant, "density") == 0) {
-        recognized = REF_TRUE;
-        scalar[node] = rho;
-      } else if (strcmp(interpolant, "temperature") == 0) {
-        recognized = REF_TRUE;
-        scalar[node] = temp;
+        RSS(compressible_scalar(ref_grid, ldim, initial_field, 0, 3, 4,
+                                REF_EMPTY, type, scalar),
+            "compressible");
       }
-    }
-    if (recognized)
-      ref_mpi_stopwatch_stop(ref_mpi, "compute compressible scalar");
-  }
-
-  if (!recognized) {
-    REF_INT solb_ldim;
-    REF_DBL *solb_scalar;
-    if (ref_mpi_once(ref_mpi))
-      printf("opening %s as multiscale interpolant\n", interpolant);
-    RSS(ref_part_scalar(ref_grid, &solb_ldim, &solb_scalar, interpolant),
-        "unable to load interpolant scalar");
-    REIS(1, solb_ldim, "expected one interpolant scalar");
-    each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
-      scalar[node] = solb_scalar[node];
-    }
-    ref_free(solb_scalar);
-    ref_mpi_stopwatch_stop(ref_mpi, "read interpolant from file");
+      RSS(stage_stopwatch_stop(ref_mpi, "compute compressible scalar"),
+          "stopwatch");
+      break;
+    default:
+      RSS(interpolant_from_file(ref_grid, interpolant, scalar), "from file");
   }
 
   return REF_SUCCESS;
@@ -2573,119 +4355,71 @@ static REF_STATUS fun3d_field_scalar(REF_GRID ref_grid, REF_INT ldim,
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_INT node;
   REF_DBL gamma = 1.4;
-  REF_BOOL recognized = REF_FALSE;
+  REF_INTERPOLANT_TYPE type;
 
   RSS(ref_validation_finite(ref_grid, ldim, initial_field), "init field");
   if (ref_mpi_once(ref_mpi)) printf("compute %s\n", interpolant);
-  if (strcmp(interpolant, "incomp") == 0) {
-    recognized = REF_TRUE;
-    RAS(4 <= ldim,
-        "expected 4 or more variables per vertex for incompressible");
-    each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
-      REF_DBL u, v, w, u2;
-      u = initial_field[0 + ldim * node];
-      v = initial_field[1 + ldim * node];
-      w = initial_field[2 + ldim * node];
-      /* press = initial_field[3 + ldim * node]; */
-      u2 = u * u + v * v + w * w;
-      scalar[node] = sqrt(u2);
-    }
-    ref_mpi_stopwatch_stop(ref_mpi, "compute incompressible scalar");
-  }
-  if (strcmp(interpolant, "space-time") == 0) {
-    recognized = REF_TRUE;
-    RAS(4 <= ldim, "expected 4 or more variables per vertex for space-time");
-    each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
-      REF_DBL rho, u, v, press, temp, u2, mach2;
-      rho = initial_field[0 + ldim * node];
-      u = initial_field[1 + ldim * node];
-      v = initial_field[2 + ldim * node];
-      press = initial_field[3 + ldim * node];
-      RAB(ref_math_divisible(press, rho), "can not divide by rho", {
-        printf("rho = %e  u = %e  v = %e  press = %e\n", rho, u, v, press);
-      });
-      temp = gamma * (press / rho);
-      u2 = u * u + v * v;
-      RAB(ref_math_divisible(u2, temp), "can not divide by temp", {
-        printf("rho = %e  u = %e  v = %e  press = %e  temp = %e\n", rho, u, v,
-               press, temp);
-      });
-      mach2 = u2 / temp;
-      RAB(mach2 >= 0, "negative mach2", {
-        printf("rho = %e  u = %e  v = %e press = %e  temp = %e\n", rho, u, v,
-               press, temp);
-      });
-      scalar[node] = sqrt(mach2);
-    }
-    ref_mpi_stopwatch_stop(ref_mpi, "compute incompressible scalar");
-  }
-  if ((strcmp(interpolant, "mach") == 0) ||
-      (strcmp(interpolant, "htot") == 0) ||
-      (strcmp(interpolant, "ptot") == 0) ||
-      (strcmp(interpolant, "pressure") == 0) ||
-      (strcmp(interpolant, "density") == 0) ||
-      (strcmp(interpolant, "temperature") == 0)) {
-    RAS(5 <= ldim, "expected 5 or more variables per vertex for compressible");
-    each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
-      REF_DBL rho, u, v, w, press, temp, u2, mach2;
-      rho = initial_field[0 + ldim * node];
-      u = initial_field[1 + ldim * node];
-      v = initial_field[2 + ldim * node];
-      w = initial_field[3 + ldim * node];
-      press = initial_field[4 + ldim * node];
-      RAB(ref_math_divisible(press, rho), "can not divide by rho", {
-        printf("rho = %e  u = %e  v = %e  w = %e  press = %e\n", rho, u, v, w,
-               press);
-      });
-      temp = gamma * (press / rho);
-      u2 = u * u + v * v + w * w;
-      RAB(ref_math_divisible(u2, temp), "can not divide by temp", {
-        printf("rho = %e  u = %e  v = %e  w = %e  press = %e  temp = %e\n", rho,
-               u, v, w, press, temp);
-      });
-      mach2 = u2 / temp;
-      RAB(mach2 >= 0, "negative mach2", {
-        printf("rho = %e  u = %e  v = %e  w = %e  press = %e  temp = %e\n", rho,
-               u, v, w, press, temp);
-      });
-      if (strcmp(interpolant, "mach") == 0) {
-        recognized = REF_TRUE;
+  RSS(interpolant_type(interpolant, &type), "interpolant type");
+  switch (type) {
+    case REF_INTERPOLANT_INCOMP:
+      RAS(4 <= ldim,
+          "expected 4 or more variables per vertex for incompressible");
+      each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
+        REF_DBL u, v, w;
+        u = initial_field[0 + ldim * node];
+        v = initial_field[1 + ldim * node];
+        w = initial_field[2 + ldim * node];
+        /* press = initial_field[3 + ldim * node]; */
+        scalar[node] = sqrt(u * u + v * v + w * w);
+      }
+      RSS(stage_stopwatch_stop(ref_mpi, "compute incompressible scalar"),
+          "stopwatch");
+      break;
+    case REF_INTERPOLANT_SPACE_TIME:
+      RAS(4 <= ldim, "expected 4 or more variables per vertex for space-time");
+      each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
+        REF_DBL rho, u, v, press, temp, u2, mach2;
+        rho = initial_field[0 + ldim * node];
+        u = initial_field[1 + ldim * node];
+        v = initial_field[2 + ldim * node];
+        press = initial_field[3 + ldim * node];
+        RAB(ref_math_divisible(press, rho), "can not divide by rho", {
+          printf("rho = %e  u = %e  v = %e  press = %e\n", rho, u, v, press);
+        });
+        temp = gamma * (press / rho);
+        u2 = u * u + v * v;
+        RAB(ref_math_divisible(u2, temp), "can not divide by temp", {
+          printf("rho = %e  u = %e  v = %e  press = %e  temp = %e\n", rho, u, v,
+                 press, temp);
+        });
+        mach2 = u2 / temp;
+        RAB(mach2 >= 0, "negative mach2", {
+          printf("rho = %e  u = %e  v = %e press = %e  temp = %e\n", rho, u, v,
+                 press, temp);
+        });
         scalar[node] = sqrt(mach2);
-      } else if (strcmp(interpolant, "htot") == 0) {
-        recognized = REF_TRUE;
-        scalar[node] = temp * (1.0 / (gamma - 1.0)) + 0.5 * u2;
-      } else if (strcmp(interpolant, "ptot") == 0) {
-        recognized = REF_TRUE;
-        scalar[node] =
-            press * pow(1.0 + 0.5 * (gamma - 1.0) * mach2, gamma / (gamma - 1));
-      } else if (strcmp(interpolant, "pressure") == 0) {
-        recognized = REF_TRUE;
-        scalar[node] = press;
-      } else if (strcmp(interpolant, "density") == 0) {
-        recognized = REF_TRUE;
-        scalar[node] = rho;
-      } else if (strcmp(interpolant, "temperature") == 0) {
-        recognized = REF_TRUE;
-        scalar[node] = temp;
       }
-    }
-    if (recognized)
-      ref_mpi_stopwatch_stop(ref_mpi, "compute compressible scalar");
-  }
-
-  if (!recognized) {
-    REF_INT solb_ldim;
-    REF_DBL *solb_scalar;
-    if (ref_mpi_once(ref_mpi))
-      printf("opening %s as solb multiscale interpolant\n", interpolant);
-    RSS(ref_part_scalar(ref_grid, &solb_ldim, &solb_scalar, interpolant),
-        "unable to load interpolant scalar");
-    REIS(1, solb_ldim, "expected one interpolant scalar");
-    each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
-      scalar[node] = solb_scalar[node];
-    }
-    ref_free(solb_scalar);
-    ref_mpi_stopwatch_stop(ref_mpi, "read interpolant from file");
+      RSS(stage_stopwatch_stop(ref_mpi, "compute incompressible scalar"),
+          "stopwatch");
+      break;
+    case REF_INTERPOLANT_MACH:
+    case REF_INTERPOLANT_HTOT:
+    case REF_INTERPOLANT_PTOT:
+    case REF_INTERPOLANT_PRESSURE:
+    case REF_INTERPOLANT_DENSITY:
+    case REF_INTERPOLANT_TEMPERATURE:
+      RAS(5 <= ldim,
+          "expected 5 or more variables per vertex for compressible");
+      /* [rho,u,v,w,press] */
+      RSS(compressible_scalar(ref_grid, ldim, initial_field, 0, 3, REF_EMPTY, 4,
+                              type, scalar),
+          "compressible");
+      RSS(stage_stopwatch_stop(ref_mpi, "compute compressible scalar"),
+          "stopwatch");
+      break;
+    case REF_INTERPOLANT_FILE:
+      RSS(interpolant_from_file(ref_grid, interpolant, scalar), "from file");
+      break;
   }
 
   return REF_SUCCESS;
@@ -2748,7 +4482,7 @@ static REF_STATUS fixed_point_metric(
       RSS(ref_validation_finite(ref_grid, 6, metric), "metric sum");
   }
   free(hess);
-  ref_mpi_stopwatch_stop(ref_mpi, "all timesteps processed");
+  RSS(stage_stopwatch_stop(ref_mpi, "all timesteps processed"), "stopwatch");
 
   RAS(0 < total_timesteps, "expected one or more timesteps");
   inv_total = 1.0 / (REF_DBL)total_timesteps;
@@ -2765,12 +4499,13 @@ static REF_STATUS fixed_point_metric(
   RSS(ref_metric_local_scale(metric, ref_grid, p), "local lp norm scaling");
   RSS(ref_metric_limit_aspect_ratio(metric, ref_grid, aspect_ratio),
       "limit aspect ratio");
-  ref_mpi_stopwatch_stop(ref_mpi, "limit aspect ratio");
-  ref_mpi_stopwatch_stop(ref_mpi, "local scale metric");
+  RSS(stage_stopwatch_stop(ref_mpi, "limit aspect ratio"), "stopwatch");
+  RSS(stage_stopwatch_stop(ref_mpi, "local scale metric"), "stopwatch");
   RSS(ref_metric_gradation_at_complexity(metric, ref_grid, gradation,
                                          complexity),
       "gradation at complexity");
-  ref_mpi_stopwatch_stop(ref_mpi, "metric gradation and complexity");
+  RSS(stage_stopwatch_stop(ref_mpi, "metric gradation and complexity"),
+      "stopwatch");
 
   return REF_SUCCESS;
 }
@@ -2802,7 +4537,7 @@ static REF_STATUS ddes_fixed_point_metric(
   ref_malloc(blend, ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
   ref_malloc(distance, ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
   RSS(ref_phys_wall_distance(ref_grid, ref_dict_bcs, distance), "wall dist");
-  ref_mpi_stopwatch_stop(ref_mpi, "wall distance");
+  RSS(stage_stopwatch_stop(ref_mpi, "wall distance"), "stopwatch");
 
   ref_malloc_init(u, ref_node_max(ref_node), REF_DBL, 0.0);
   ref_malloc_init(gradu, 3 * ref_node_max(ref_node), REF_DBL, 0.0);
@@ -2811,13 +4546,13 @@ static REF_STATUS ddes_fixed_point_metric(
 
   each_ref_node_valid_node(ref_node, node) { u[node] = field[1 + ldim * node]; }
   RSS(ref_recon_gradient(ref_grid, u, gradu, reconstruction), "gu");
-  ref_mpi_stopwatch_stop(ref_mpi, "gradu");
+  RSS(stage_stopwatch_stop(ref_mpi, "gradu"), "stopwatch");
   each_ref_node_valid_node(ref_node, node) { u[node] = field[2 + ldim * node]; }
   RSS(ref_recon_gradient(ref_grid, u, gradv, reconstruction), "gv");
-  ref_mpi_stopwatch_stop(ref_mpi, "gradv");
+  RSS(stage_stopwatch_stop(ref_mpi, "gradv"), "stopwatch");
   each_ref_node_valid_node(ref_node, node) { u[node] = field[3 + ldim * node]; }
   RSS(ref_recon_gradient(ref_grid, u, gradw, reconstruction), "gw");
-  ref_mpi_stopwatch_stop(ref_mpi, "gradw");
+  RSS(stage_stopwatch_stop(ref_mpi, "gradw"), "stopwatch");
 
   each_ref_node_valid_node(ref_node, node) {
     REF_DBL sqrtgrad;
@@ -2860,7 +4595,7 @@ static REF_STATUS ddes_fixed_point_metric(
     }
   }
   free(hess);
-  ref_mpi_stopwatch_stop(ref_mpi, "all timesteps processed");
+  RSS(stage_stopwatch_stop(ref_mpi, "all timesteps processed"), "stopwatch");
 
   RAS(0 < total_timesteps, "expected one or more timesteps");
   inv_total = 1.0 / (REF_DBL)total_timesteps;
@@ -2872,7 +4607,7 @@ static REF_STATUS ddes_fixed_point_metric(
   RSS(ref_recon_roundoff_limit(metric, ref_grid),
       "floor metric eigenvalues based on grid size and solution jitter");
   RSS(ref_metric_local_scale(metric, ref_grid, p), "local lp norm scaling");
-  ref_mpi_stopwatch_stop(ref_mpi, "local scale metric");
+  RSS(stage_stopwatch_stop(ref_mpi, "local scale metric"), "stopwatch");
 
   ref_malloc(aspect_ratio_field, ref_node_max(ref_grid_node(ref_grid)),
              REF_DBL);
@@ -2898,7 +4633,8 @@ static REF_STATUS ddes_fixed_point_metric(
   RSS(ref_metric_gradation_at_complexity(metric, ref_grid, gradation,
                                          complexity),
       "gradation at complexity");
-  ref_mpi_stopwatch_stop(ref_mpi, "metric gradation and complexity");
+  RSS(stage_stopwatch_stop(ref_mpi, "metric gradation and complexity"),
+      "stopwatch");
 
   return REF_SUCCESS;
 }
@@ -3024,7 +4760,7 @@ static REF_STATUS moving_fixed_point_metric(
   free(jac);
   free(this_metric);
   free(hess);
-  ref_mpi_stopwatch_stop(ref_mpi, "all timesteps processed");
+  RSS(stage_stopwatch_stop(ref_mpi, "all timesteps processed"), "stopwatch");
 
   RAS(0 < total_timesteps, "expected one or more timesteps");
   inv_total = 1.0 / (REF_DBL)total_timesteps;
@@ -3036,11 +4772,12 @@ static REF_STATUS moving_fixed_point_metric(
   RSS(ref_recon_roundoff_limit(metric, ref_grid),
       "floor metric eigenvalues based on grid size and solution jitter");
   RSS(ref_metric_local_scale(metric, ref_grid, p), "local lp norm scaling");
-  ref_mpi_stopwatch_stop(ref_mpi, "local scale metric");
+  RSS(stage_stopwatch_stop(ref_mpi, "local scale metric"), "stopwatch");
   RSS(ref_metric_gradation_at_complexity(metric, ref_grid, gradation,
                                          complexity),
       "gradation at complexity");
-  ref_mpi_stopwatch_stop(ref_mpi, "metric gradation and complexity");
+  RSS(stage_stopwatch_stop(ref_mpi, "metric gradation and complexity"),
+      "stopwatch");
   return REF_SUCCESS;
 }
 
@@ -3061,6 +4798,64 @@ static REF_STATUS remove_initial_field_adjoint(REF_NODE ref_node, REF_INT *ldim,
   return REF_SUCCESS;
 }
 
+static REF_STATUS stash_field_float(REF_NODE ref_node, REF_INT ldim,
+                                    REF_DBL *field, float **stash) {
+  REF_INT i, node;
+  ref_malloc_init(*stash, ldim * ref_node_max(ref_node), float, 0.0f);
+  each_ref_node_valid_node(ref_node, node) {
+    for (i = 0; i < ldim; i++) {
+      (*stash)[i + ldim * node] = (float)field[i + ldim * node];
+    }
+  }
+  return REF_SUCCESS;
+}
+
+static REF_STATUS recall_field_float(REF_NODE ref_node, REF_INT ldim,
+                                     float *stash, REF_DBL **field) {
+  REF_INT i, node;
+  ref_malloc_init(*field, ldim * ref_node_max(ref_node), REF_DBL, 0.0);
+  each_ref_node_valid_node(ref_node, node) {
+    for (i = 0; i < ldim; i++) {
+      (*field)[i + ldim * node] = (REF_DBL)stash[i + ldim * node];
+    }
+  }
+  return REF_SUCCESS;
+}
+
+/* loop holds at most one scratch stash, file scope so a failed loop
+ * can close it (tmpfile is removed on close) */
+static FILE *stash_scratch = NULL;
+
+static REF_STATUS stash_scratch_close(void) {
+  if (NULL != stash_scratch) fclose(stash_scratch);
+  stash_scratch = NULL;
+  return REF_SUCCESS;
+}
+
+static REF_STATUS stash_field_scratch(REF_NODE ref_node, REF_INT ldim,
+                                      REF_DBL *field) {
+  size_t n = (size_t)ldim * (size_t)ref_node_max(ref_node);
+  RSS(stash_scratch_close(), "close previous");
+  stash_scratch = tmpfile();
+  RNS(stash_scratch, "unable to open scratch file");
+  RAB(n == fwrite(field, sizeof(REF_DBL), n, stash_scratch), "write scratch",
+      { stash_scratch_close(); });
+  RAB(0 == fflush(stash_scratch), "flush scratch", { stash_scratch_close(); });
+  return REF_SUCCESS;
+}
+
+static REF_STATUS recall_field_scratch(REF_NODE ref_node, REF_INT ldim,
+                                       REF_DBL **field) {
+  size_t n = (size_t)ldim * (size_t)ref_node_max(ref_node);
+  RNS(stash_scratch, "no scratch stash");
+  ref_malloc(*field, ldim * ref_node_max(ref_node), REF_DBL);
+  rewind(stash_scratch);
+  RAB(n == fread(*field, sizeof(REF_DBL), n, stash_scratch), "read scratch",
+      { stash_scratch_close(); });
+  RSS(stash_scratch_close(), "close scratch");
+  return REF_SUCCESS;
+}
+
 static REF_STATUS mask_strong_bc_adjoint(REF_GRID ref_grid,
                                          REF_DICT ref_dict_bcs, REF_INT ldim,
                                          REF_DBL *prim_dual) {
@@ -3074,6 +4869,38 @@ static REF_STATUS mask_strong_bc_adjoint(REF_GRID ref_grid,
   return REF_SUCCESS;
 }
 
+/* repeats the flip, displacement extraction, strong bc mask, and
+ * adjoint removal applied to the eagerly read field */
+static REF_STATUS reread_initial_field(REF_GRID ref_grid, const char *filename,
+                                       REF_DICT ref_dict_bcs,
+                                       REF_BOOL flip_twod, REF_BOOL deforming,
+                                       REF_BOOL adjoint, REF_INT *ldim,
+                                       REF_DBL **initial_field) {
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_DBL *displaced = NULL;
+  if (ref_mpi_once(ref_mpi)) printf("reread scalar %s\n", filename);
+  RSS(ref_part_scalar(ref_grid, ldim, initial_field, filename), "part scalar");
+  if (flip_twod) {
+    RSS(ref_phys_flip_twod_yz(ref_grid_node(ref_grid), *ldim, *initial_field),
+        "flip");
+  }
+  if (deforming) {
+    RSS(extract_displaced_xyz(ref_grid_node(ref_grid), ldim, initial_field,
+                              &displaced),
+        "extract displacments");
+    ref_free(displaced);
+  }
+  if (adjoint) {
+    RSS(mask_strong_bc_adjoint(ref_grid, ref_dict_bcs, *ldim, *initial_field),
+        "mask");
+    RSS(remove_initial_field_adjoint(ref_grid_node(ref_grid), ldim,
+                                     initial_field),
+        "rm adjoint");
+  }
+  RSS(stage_stopwatch_stop(ref_mpi, "reread scalar"), "stopwatch");
+  return REF_SUCCESS;
+}
+
 static REF_STATUS parse_p(int argc, char *argv[], REF_INT *p) {
   REF_INT pos;
   *p = 2;
@@ -3100,19 +4927,43 @@ static REF_STATUS parse_p(int argc, char *argv[], REF_INT *p) {
   return REF_SUCCESS;
 }
 
-REF_FCN static REF_STATUS ref_subcommand_report_error(
-    REF_DBL *metric, REF_GRID ref_grid, REF_DBL *scalar,
-    REF_RECON_RECONSTRUCTION reconstruction, REF_DBL complexity) {
-  REF_DBL *hess, *error;
+/* ref_metric_lp that also returns the raw reconstructed Hessian in hess
+ * (when hess is not NULL) so the error estimate does not reconstruct it */
+REF_FCN static REF_STATUS ref_subcommand_multiscale_metric(
+    REF_DBL *metric, REF_DBL *hess, REF_GRID ref_grid, REF_DBL *scalar,
+    REF_RECON_RECONSTRUCTION reconstruction, REF_INT p, REF_DBL gradation,
+    REF_DBL aspect_ratio, REF_DBL complexity) {
+  REF_INT i, node;
+  RSS(ref_recon_hessian(ref_grid, scalar, metric, reconstruction), "hess");
+  if (NULL != hess) {
+    each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
+      for (i = 0; i < 6; i++) {
+        hess[i + 6 * node] = metric[i + 6 * node];
+      }
+    }
+  }
+  RSS(ref_recon_roundoff_limit(metric, ref_grid),
+      "floor metric eigenvalues based on grid size and solution jitter");
+  RSS(ref_metric_local_scale(metric, ref_grid, p), "local lp norm scaling");
+  RSS(ref_metric_limit_aspect_ratio(metric, ref_grid, aspect_ratio),
+      "limit aspect ratio");
+  RSS(ref_metric_gradation_at_complexity(metric, ref_grid, gradation,
+                                         complexity),
+      "gradation at complexity");
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_subcommand_report_error(REF_DBL *metric,
+                                                      REF_GRID ref_grid,
+                                                      REF_DBL *hess,
+                                                      REF_DBL complexity) {
+  REF_DBL *error;
   REF_DBL total_error, h, d;
-  ref_malloc(hess, 6 * ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
   ref_malloc(error, ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
 
-  RSS(ref_recon_hessian(ref_grid, scalar, hess, reconstruction), "hess");
   RSS(ref_metric_interpolation_error(metric, hess, ref_grid, error), "error")
   RSS(ref_metric_integrate_error(ref_grid, error, &total_error), "int")
   ref_free(error);
-  ref_free(hess);
   d = 3.0;
   if (ref_grid_twod(ref_grid)) d = 2.0;
   h = pow(complexity, -1.0 / d);
@@ -3122,6 +4973,136 @@ REF_FCN static REF_STATUS ref_subcommand_report_error(
   return REF_SUCCESS;
 }
 
+/* geometry association and curvature constraint of the node metric
+ * before the background is cached, shared by loop, the analytic cycles,
+ * and pipeline adapt */
+static REF_STATUS adapt_geom_prepare(REF_GRID ref_grid) {
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  if (ref_geom_model_loaded(ref_grid_geom(ref_grid))) {
+    ref_grid_surf(ref_grid) = ref_grid_twod(ref_grid);
+    RSS(ref_egads_mark_jump_degen(ref_grid), "T and UV jumps; UV degen");
+  }
+  if (ref_geom_model_loaded(ref_grid_geom(ref_grid)) ||
+      ref_geom_meshlinked(ref_grid_geom(ref_grid))) {
+    RSS(ref_geom_verify_topo(ref_grid), "geom topo");
+    RSS(ref_geom_verify_param(ref_grid), "geom param");
+    RSS(stage_stopwatch_stop(ref_mpi, "geom assoc"), "stopwatch");
+    RSS(ref_metric_constrain_curvature(ref_grid), "crv const");
+    RSS(ref_validation_cell_volume(ref_grid), "vol");
+    RSS(stage_stopwatch_stop(ref_mpi, "crv const"), "stopwatch");
+  }
+  return REF_SUCCESS;
+}
+
+/* adapt cycles to the analytic fixture Mach field in place of a solver */
+static REF_STATUS analytic_loop(REF_GRID ref_grid, const char *out_project,
+                                REF_INT cycles, REF_INT passes, REF_INT p,
+                                REF_DBL gradation, REF_DBL aspect_ratio,
+                                REF_DBL complexity) {
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_DBL *scalar, *metric, *field;
+  REF_DBL prim[5], gamma = 1.4;
+  REF_DBL start, seconds, max_seconds, achieved;
+  REF_INT cycle, pass, node, i;
+  REF_BOOL all_done, all_done0, all_done1;
+  char filename[1024];
+
+  for (cycle = 0; cycle < cycles; cycle++) {
+    start = subcommand_wall_time();
+    if (ref_mpi_once(ref_mpi))
+      printf("\n analytic cycle %d of %d\n", cycle + 1, cycles);
+    snprintf(filename, 1024, "cycle %d", cycle + 1);
+    RSS(stage_scope_set(filename), "scope");
+    ref_malloc(scalar, ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
+    ref_malloc(metric, 6 * ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
+    each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
+      RSS(fixture_flow(ref_node_xyz_ptr(ref_grid_node(ref_grid), node), 0.5,
+                       prim),
+          "flow");
+      scalar[node] = sqrt(prim[1] * prim[1] + prim[2] * prim[2] +
+                          prim[3] * prim[3]) /
+                     sqrt(gamma * prim[4] / prim[0]);
+    }
+    RSS(ref_subcommand_multiscale_metric(metric, NULL, ref_grid, scalar,
+                                         REF_RECON_L2PROJECTION, p, gradation,
+                                         aspect_ratio, complexity),
+        "lp norm");
+    ref_free(scalar);
+    RSS(ref_metric_to_node(metric, ref_grid_node(ref_grid)), "node metric");
+    ref_free(metric);
+    RSS(stage_stopwatch_stop(ref_mpi, "analytic multiscale metric"),
+        "stopwatch");
+    RSS(adapt_geom_prepare(ref_grid), "geom prepare");
+    RSS(ref_grid_cache_background(ref_grid), "cache");
+    RSS(stage_stopwatch_stop(ref_mpi, "cache background metric"), "stopwatch");
+
+    all_done = REF_FALSE;
+    all_done0 = REF_FALSE;
+    all_done1 = REF_FALSE;
+    for (pass = 0; !all_done && pass < passes; pass++) {
+      RSS(stage_pass_set(pass), "scope");
+      all_done1 = all_done0;
+      RSS(ref_adapt_pass(ref_grid, &all_done0), "pass");
+      all_done = all_done0 && all_done1 && (pass > MIN(5, passes));
+      RSS(ref_metric_synchronize(ref_grid), "sync with background");
+      RSS(stage_stopwatch_stop(ref_mpi, "metric sync"), "stopwatch");
+      RSS(ref_validation_cell_volume(ref_grid), "vol");
+      RSS(ref_adapt_tattle_faces(ref_grid), "tattle");
+      RSS(stage_stopwatch_stop(ref_mpi, "tattle faces"), "stopwatch");
+      RSS(ref_migrate_to_balance(ref_grid), "balance");
+      RSS(ref_grid_pack(ref_grid), "pack");
+      RSS(stage_stopwatch_stop(ref_mpi, "pack"), "stopwatch");
+    }
+    RSS(stage_pass_set(REF_EMPTY), "scope");
+
+    RSS(ref_grid_free(ref_grid_background(ref_grid)),
+        "free cached background grid");
+    ref_grid_background(ref_grid) = NULL;
+    RSS(ref_interp_free(ref_grid_interp(ref_grid)), "interp free");
+    ref_grid_interp(ref_grid) = NULL;
+
+    ref_malloc(metric, 6 * ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
+    RSS(ref_metric_from_node(metric, ref_grid_node(ref_grid)), "get node");
+    RSS(ref_metric_complexity(metric, ref_grid, &achieved), "cmp");
+    ref_free(metric);
+    seconds = subcommand_wall_time() - start;
+    RSS(ref_mpi_max(ref_mpi, &seconds, &max_seconds, REF_DBL_TYPE), "max");
+    if (ref_mpi_once(ref_mpi))
+      printf("cycle %d complexity %e of %e with " REF_GLOB_FMT
+             " nodes in %.3f seconds\n",
+             cycle + 1, achieved, complexity,
+             ref_node_n_global(ref_grid_node(ref_grid)), max_seconds);
+  }
+  RSS(stage_scope_set(NULL), "scope");
+
+  RSS(ref_node_implicit_global_from_local(ref_grid_node(ref_grid)),
+      "implicit global");
+  RSS(ref_geom_verify_param(ref_grid), "final params");
+  RSS(stage_stopwatch_stop(ref_mpi, "verify final params"), "stopwatch");
+  snprintf(filename, 1024, "%s.meshb", out_project);
+  if (ref_mpi_once(ref_mpi))
+    printf("gather " REF_GLOB_FMT " nodes to %s\n",
+           ref_node_n_global(ref_grid_node(ref_grid)), filename);
+  RSS(ref_gather_by_extension(ref_grid, filename), "gather meshb");
+  RSS(stage_stopwatch_stop(ref_mpi, "gather meshb"), "stopwatch");
+
+  ref_malloc(field, 5 * ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
+  each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
+    RSS(fixture_flow(ref_node_xyz_ptr(ref_grid_node(ref_grid), node), 0.5,
+                     prim),
+        "flow");
+    for (i = 0; i < 5; i++) field[i + 5 * node] = prim[i];
+  }
+  snprintf(filename, 1024, "%s_volume.solb", out_project);
+  if (ref_mpi_once(ref_mpi)) printf("gather analytic field %s\n", filename);
+  RSS(ref_gather_scalar_by_extension(ref_grid, 5, field, NULL, filename),
+      "gather volume");
+  ref_free(field);
+  RSS(stage_stopwatch_stop(ref_mpi, "gather volume"), "stopwatch");
+
+  return REF_SUCCESS;
+}
+
 static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
   char *in_project = NULL;
   char *out_project = NULL;
@@ -3142,6 +5123,17 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
   REF_DBL aspect_ratio = -1.0;
   REF_RECON_RECONSTRUCTION reconstruction = REF_RECON_L2PROJECTION;
   REF_BOOL buffer = REF_FALSE;
+  REF_BOOL report_error = REF_TRUE;
+  REF_BOOL lazy_field = REF_FALSE;
+  REF_BOOL flip_twod = REF_FALSE;
+  REF_BOOL field_adjoint = REF_FALSE;
+  REF_INT stashed_ldim = 0;
+  const char *aux_storage = "double";
+  float *aux_float = NULL;
+  REF_BOOL report_passes = REF_FALSE;
+  REF_DBL pass_seconds[REF_PASS_REPORT_STAGES], pass_time;
+  REF_DBL conformity = -1.0, last_conformity = 0.0;
+  REF_BOOL conformed = REF_FALSE;
   REF_BOOL multiscale_metric;
   REF_DICT ref_dict_bcs = NULL;
   REF_BOOL strong_sensor_bc = REF_FALSE;
@@ -3222,6 +5214,43 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
     buffer = REF_TRUE;
   }
 
+  RXS(ref_args_find(argc, argv, "--no-error-report", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    report_error = REF_FALSE;
+  }
+
+  RXS(ref_args_find(argc, argv, "--lazy-field", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    lazy_field = REF_TRUE;
+  }
+
+  RXS(ref_args_find(argc, argv, "--aux-storage", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    if (pos >= argc - 1) {
+      if (ref_mpi_once(ref_mpi))
+        printf("option missing value: --aux-storage <double|float|scratch>\n");
+      goto shutdown;
+    }
+    aux_storage = argv[pos + 1];
+    if (0 != strcmp(aux_storage, "double") &&
+        0 != strcmp(aux_storage, "float") &&
+        0 != strcmp(aux_storage, "scratch")) {
+      if (ref_mpi_once(ref_mpi))
+        printf("unknown --aux-storage %s, expected double, float, scratch\n",
+               aux_storage);
+      goto shutdown;
+    }
+    if (ref_mpi_once(ref_mpi)) printf("--aux-storage %s\n", aux_storage);
+    if (lazy_field && 0 != strcmp(aux_storage, "double")) {
+      if (ref_mpi_once(ref_mpi))
+        printf("--aux-storage %s conflicts with --lazy-field\n", aux_storage);
+      goto shutdown;
+    }
+  }
+
   RXS(ref_args_find(argc, argv, "--interpolant", &pos), REF_NOT_FOUND,
       "arg search");
   if (REF_EMPTY != pos && pos < argc - 1) {
@@ -3315,13 +5344,13 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
     if (ref_mpi_once(ref_mpi)) printf("part mesh %s\n", filename);
     RSS(ref_import_by_extension(&ref_grid, ref_mpi, filename), "part");
     ref_mpi = ref_grid_mpi(ref_grid); /* ref_grid made a deep copy */
-    ref_mpi_stopwatch_stop(ref_mpi, "part");
+    RSS(stage_stopwatch_stop(ref_mpi, "part"), "stopwatch");
   } else {
     snprintf(filename, 1024, "%s.meshb", in_project);
     if (ref_mpi_once(ref_mpi)) printf("part mesh %s\n", filename);
     RSS(ref_part_by_extension(&ref_grid, ref_mpi, filename), "part");
     ref_mpi = ref_grid_mpi(ref_grid); /* ref_grid made a deep copy */
-    ref_mpi_stopwatch_stop(ref_mpi, "part");
+    RSS(stage_stopwatch_stop(ref_mpi, "part"), "stopwatch");
   }
   if (ref_mpi_once(ref_mpi))
     printf("  read " REF_GLOB_FMT " vertices\n",
@@ -3383,7 +5412,7 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
       RSS(ref_egads_load(ref_grid_geom(ref_grid), in_egads), "load egads");
       if (ref_mpi_once(ref_mpi) && ref_geom_effective(ref_grid_geom(ref_grid)))
         printf("EBody Effective Body loaded\n");
-      ref_mpi_stopwatch_stop(ref_mpi, "load egads");
+      RSS(stage_stopwatch_stop(ref_mpi, "load egads"), "stopwatch");
     } else {
       if (0 < ref_geom_cad_data_size(ref_grid_geom(ref_grid))) {
         if (ref_mpi_once(ref_mpi))
@@ -3392,7 +5421,8 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
         if (ref_mpi_once(ref_mpi) &&
             ref_geom_effective(ref_grid_geom(ref_grid)))
           printf("EBody Effective Body loaded\n");
-        ref_mpi_stopwatch_stop(ref_mpi, "load egadslite cad data");
+        RSS(stage_stopwatch_stop(ref_mpi, "load egadslite cad data"),
+            "stopwatch");
       } else {
         if (ref_mpi_once(ref_mpi))
           printf("warning: no geometry loaded, assuming planar faces.\n");
@@ -3405,7 +5435,7 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
   if (REF_EMPTY != pos && pos < argc - 1) {
     if (ref_mpi_once(ref_mpi)) printf("--facelift %s import\n", argv[pos + 1]);
     RSS(ref_facelift_import(ref_grid, argv[pos + 1]), "attach");
-    ref_mpi_stopwatch_stop(ref_mpi, "facelift loaded");
+    RSS(stage_stopwatch_stop(ref_mpi, "facelift loaded"), "stopwatch");
   }
 
   RXS(ref_args_find(argc, argv, "--surrogate", &pos), REF_NOT_FOUND,
@@ -3413,24 +5443,52 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
   if (REF_EMPTY != pos && pos < argc - 1) {
     if (ref_mpi_once(ref_mpi)) printf("--surrogate %s import\n", argv[pos + 1]);
     RSS(ref_facelift_surrogate(ref_grid, argv[pos + 1]), "attach");
-    ref_mpi_stopwatch_stop(ref_mpi, "facelift loaded");
+    RSS(stage_stopwatch_stop(ref_mpi, "facelift loaded"), "stopwatch");
     if (ref_mpi_once(ref_mpi)) printf("constrain all\n");
     RSS(ref_geom_constrain_all(ref_grid), "constrain");
-    ref_mpi_stopwatch_stop(ref_mpi, "constrain param");
+    RSS(stage_stopwatch_stop(ref_mpi, "constrain param"), "stopwatch");
     if (ref_mpi_once(ref_mpi)) printf("verify constrained param\n");
     RSS(ref_geom_verify_param(ref_grid), "constrained params");
-    ref_mpi_stopwatch_stop(ref_mpi, "verify param");
+    RSS(stage_stopwatch_stop(ref_mpi, "verify param"), "stopwatch");
+  }
+
+  RXS(ref_args_find(argc, argv, "--analytic-cycles", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    REF_INT report_pos, conformity_pos;
+    if (pos >= argc - 1) {
+      if (ref_mpi_once(ref_mpi))
+        printf("option missing value: --analytic-cycles <cycles>\n");
+      goto shutdown;
+    }
+    RXS(ref_args_find(argc, argv, "--pass-report", &report_pos), REF_NOT_FOUND,
+        "arg search");
+    RXS(ref_args_find(argc, argv, "--conformity", &conformity_pos),
+        REF_NOT_FOUND, "arg search");
+    if (REF_EMPTY != report_pos || REF_EMPTY != conformity_pos) {
+      if (ref_mpi_once(ref_mpi))
+        printf("--analytic-cycles does not support --pass-report or "
+               "--conformity\n");
+      goto shutdown;
+    }
+    RSS(analytic_loop(ref_grid, out_project, atoi(argv[pos + 1]), passes, p,
+                      gradation, aspect_ratio, complexity),
+        "analytic loop");
+    RSS(ref_dict_free(ref_dict_bcs), "free");
+    RSS(ref_grid_free(ref_grid), "free");
+    return REF_SUCCESS;
   }
 
   snprintf(filename, 1024, "%s%s", in_project, soln_import_extension);
   if (ref_mpi_once(ref_mpi)) printf("part scalar %s\n", filename);
   RSS(ref_part_scalar(ref_grid, &ldim, &initial_field, filename),
       "part scalar");
-  ref_mpi_stopwatch_stop(ref_mpi, "part scalar");
+  RSS(stage_stopwatch_stop(ref_mpi, "part scalar"), "stopwatch");
 
-  if (ref_grid_twod(ref_grid) &&
-      0 != strcmp(soln_import_extension, locichem_soln) &&
-      0 != strcmp(soln_import_extension, avm_soln)) {
+  flip_twod = (ref_grid_twod(ref_grid) &&
+               0 != strcmp(soln_import_extension, locichem_soln) &&
+               0 != strcmp(soln_import_extension, avm_soln));
+  if (flip_twod) {
     if (ref_mpi_once(ref_mpi)) printf("flip initial_field v-w for twod\n");
     RSS(ref_phys_flip_twod_yz(ref_grid_node(ref_grid), ldim, initial_field),
         "flip");
@@ -3470,6 +5528,7 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
     RSS(remove_initial_field_adjoint(ref_grid_node(ref_grid), &ldim,
                                      &initial_field),
         "rm adjoint");
+    field_adjoint = REF_TRUE;
   }
   RXS(ref_args_find(argc, argv, "--cons-euler", &pos), REF_NOT_FOUND,
       "arg search");
@@ -3496,6 +5555,7 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
     RSS(remove_initial_field_adjoint(ref_grid_node(ref_grid), &ldim,
                                      &initial_field),
         "rm adjoint");
+    field_adjoint = REF_TRUE;
   }
   RXS(ref_args_find(argc, argv, "--cons-visc", &pos), REF_NOT_FOUND,
       "arg search");
@@ -3535,6 +5595,7 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
     RSS(remove_initial_field_adjoint(ref_grid_node(ref_grid), &ldim,
                                      &initial_field),
         "rm adjoint");
+    field_adjoint = REF_TRUE;
   }
   RXS(ref_args_find(argc, argv, "--fixed-point", &pos), REF_NOT_FOUND,
       "arg search");
@@ -3587,65 +5648,125 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
     }
   }
   if (multiscale_metric) {
+    /* comma-separated interpolants, each metric intersected with the last */
+    char interpolant_list[1024];
+    char *next_interpolant, *comma;
+    const char *this_interpolant;
+    REF_DBL *this_metric = NULL, *interpolant_metric;
+    REF_INT n_interpolant = 0, node;
+    RAS(strlen(interpolant) < 1024, "--interpolant list too long");
+    snprintf(interpolant_list, 1024, "%s", interpolant);
     ref_malloc(scalar, ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
-    if (ref_mpi_once(ref_mpi))
-      printf("computing interpolant %s for multiscale metric\n", interpolant);
-    if (0 == strcmp(soln_import_extension, locichem_soln)) {
-      if (ref_mpi_once(ref_mpi)) printf("assuming Loci/CHEM format\n");
-      RSS(locichem_field_scalar(ref_grid, ldim, initial_field, interpolant,
-                                scalar),
-          "Loci/CHEM scalar field reduction");
-    } else if (0 == strcmp(soln_import_extension, avm_soln)) {
-      if (ref_mpi_once(ref_mpi)) printf("assuming AV (COFFE) format\n");
-      RSS(avm_field_scalar(ref_grid, ldim, initial_field, interpolant, scalar),
-          "AV scalar field reduction");
-    } else {
+    next_interpolant = interpolant_list;
+    while (NULL != next_interpolant) {
+      this_interpolant = next_interpolant;
+      comma = strchr(next_interpolant, ',');
+      if (NULL != comma) {
+        *comma = '\0';
+        next_interpolant = comma + 1;
+      } else {
+        next_interpolant = NULL;
+      }
+      interpolant_metric = metric;
+      if (0 < n_interpolant) {
+        if (NULL == this_metric)
+          ref_malloc_init(this_metric,
+                          6 * ref_node_max(ref_grid_node(ref_grid)), REF_DBL,
+                          0.0);
+        interpolant_metric = this_metric;
+      }
+
       if (ref_mpi_once(ref_mpi))
-        printf("assuming FUN3D equivalent format and nondimensional\n");
-      RSS(fun3d_field_scalar(ref_grid, ldim, initial_field, interpolant,
+        printf("computing interpolant %s for multiscale metric\n",
+               this_interpolant);
+      if (0 == strcmp(soln_import_extension, locichem_soln)) {
+        if (ref_mpi_once(ref_mpi)) printf("assuming Loci/CHEM format\n");
+        RSS(locichem_field_scalar(ref_grid, ldim, initial_field,
+                                  this_interpolant, scalar),
+            "Loci/CHEM scalar field reduction");
+      } else if (0 == strcmp(soln_import_extension, avm_soln)) {
+        if (ref_mpi_once(ref_mpi)) printf("assuming AV (COFFE) format\n");
+        RSS(avm_field_scalar(ref_grid, ldim, initial_field, this_interpolant,
                              scalar),
-          "FUN3D scalar field reduction");
-    }
+            "AV scalar field reduction");
+      } else {
+        if (ref_mpi_once(ref_mpi))
+          printf("assuming FUN3D equivalent format and nondimensional\n");
+        RSS(fun3d_field_scalar(ref_grid, ldim, initial_field, this_interpolant,
+                               scalar),
+            "FUN3D scalar field reduction");
+      }
 
-    if (strong_sensor_bc) {
-      RSS(ref_phys_strong_sensor_bc(ref_grid, scalar, strong_value,
-                                    ref_dict_bcs),
-          "apply strong sensor bc");
-    }
+      if (strong_sensor_bc) {
+        RSS(ref_phys_strong_sensor_bc(ref_grid, scalar, strong_value,
+                                      ref_dict_bcs),
+            "apply strong sensor bc");
+      }
 
-    RXS(ref_args_find(argc, argv, "--deforming", &pos), REF_NOT_FOUND,
-        "arg search");
-    if (REF_EMPTY != pos) {
-      if (ref_mpi_once(ref_mpi))
-        printf("reconstruct Hessian, compute metric\n");
-      RSS(ref_metric_moving_multiscale(metric, ref_grid, displaced, scalar,
-                                       reconstruction, p, gradation,
-                                       complexity),
-          "lp norm");
-      ref_mpi_stopwatch_stop(ref_mpi, "deforming metric");
-    } else {
-      RXS(ref_args_find(argc, argv, "--mixed", &pos), REF_NOT_FOUND,
+      RXS(ref_args_find(argc, argv, "--deforming", &pos), REF_NOT_FOUND,
           "arg search");
       if (REF_EMPTY != pos) {
-        if (ref_mpi_once(ref_mpi))
-          printf("reconstruct Hessian, metric from sensor and infer mixed\n");
-        RSS(ref_metric_lp_mixed(metric, ref_grid, scalar, reconstruction, p,
-                                gradation, complexity),
-            "lp norm");
-        ref_mpi_stopwatch_stop(ref_mpi, "mixed metric");
-      } else {
         if (ref_mpi_once(ref_mpi))
           printf("reconstruct Hessian, compute metric\n");
-        RSS(ref_metric_lp(metric, ref_grid, scalar, reconstruction, p,
-                          aspect_ratio, gradation, complexity),
+        RSS(ref_metric_moving_multiscale(interpolant_metric, ref_grid,
+                                         displaced, scalar, reconstruction, p,
+                                         gradation, complexity),
             "lp norm");
-        ref_mpi_stopwatch_stop(ref_mpi, "multiscale metric");
-        RSS(ref_subcommand_report_error(metric, ref_grid, scalar,
-                                        reconstruction, complexity),
-            "report error");
+        RSS(stage_stopwatch_stop(ref_mpi, "deforming metric"), "stopwatch");
+      } else {
+        RXS(ref_args_find(argc, argv, "--mixed", &pos), REF_NOT_FOUND,
+            "arg search");
+        if (REF_EMPTY != pos) {
+          if (ref_mpi_once(ref_mpi))
+            printf("reconstruct Hessian, metric from sensor and infer mixed\n");
+          RSS(ref_metric_lp_mixed(interpolant_metric, ref_grid, scalar,
+                                  reconstruction, p, gradation, complexity),
+              "lp norm");
+          RSS(stage_stopwatch_stop(ref_mpi, "mixed metric"), "stopwatch");
+        } else {
+          REF_DBL *hess = NULL;
+          if (report_error)
+            ref_malloc(hess, 6 * ref_node_max(ref_grid_node(ref_grid)),
+                       REF_DBL);
+          if (ref_mpi_once(ref_mpi))
+            printf("reconstruct Hessian, compute metric\n");
+          RSS(ref_subcommand_multiscale_metric(
+                  interpolant_metric, hess, ref_grid, scalar, reconstruction,
+                  p, gradation, aspect_ratio, complexity),
+              "lp norm");
+          RSS(stage_stopwatch_stop(ref_mpi, "multiscale metric"), "stopwatch");
+          if (report_error) {
+            RSS(ref_subcommand_report_error(interpolant_metric, ref_grid, hess,
+                                            complexity),
+                "report error");
+            RSS(stage_stopwatch_stop(ref_mpi, "error estimate"), "stopwatch");
+          }
+          ref_free(hess);
+        }
       }
+
+      if (0 < n_interpolant) {
+        each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
+          REF_DBL m[6];
+          RSS(ref_matrix_intersect(&(metric[6 * node]),
+                                   &(this_metric[6 * node]), m),
+              "intersect");
+          for (pos = 0; pos < 6; pos++) metric[pos + 6 * node] = m[pos];
+        }
+        RSS(stage_stopwatch_stop(ref_mpi, "intersect interpolant metric"),
+            "stopwatch");
+      }
+      n_interpolant++;
     }
+    ref_free(this_metric);
     ref_free(scalar);
+    if (1 < n_interpolant) {
+      REF_DBL current_complexity;
+      RSS(ref_metric_complexity(metric, ref_grid, &current_complexity), "cmp");
+      if (ref_mpi_once(ref_mpi))
+        printf("%d interpolants intersected, complexity %e\n", n_interpolant,
+               current_complexity);
+    }
   }
 
   RXS(ref_args_find(argc, argv, "--yplus", &pos), REF_NOT_FOUND, "arg search");
@@ -3699,7 +5820,7 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
     if (ref_mpi_once(ref_mpi)) printf("buffer at complexity %e\n", complexity);
     RSS(ref_metric_buffer_at_complexity(metric, ref_grid, complexity),
         "buffer at complexity");
-    ref_mpi_stopwatch_stop(ref_mpi, "buffer");
+    RSS(stage_stopwatch_stop(ref_mpi, "buffer"), "stopwatch");
   }
 
   RXS(ref_args_find(argc, argv, "--uniform", &pos), REF_NOT_FOUND,
@@ -3717,53 +5838,92 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
     snprintf(filename, 1024, "%s-metric.solb", in_project);
     if (ref_mpi_once(ref_mpi)) printf("export metric to %s\n", filename);
     RSS(ref_gather_metric(ref_grid, filename), "export metric");
-    ref_mpi_stopwatch_stop(ref_mpi, "export metric");
+    RSS(stage_stopwatch_stop(ref_mpi, "export metric"), "stopwatch");
   }
 
-  if (ref_geom_model_loaded(ref_grid_geom(ref_grid))) {
-    ref_grid_surf(ref_grid) = ref_grid_twod(ref_grid);
-    RSS(ref_egads_mark_jump_degen(ref_grid), "T and UV jumps; UV degen");
-  }
-  if (ref_geom_model_loaded(ref_grid_geom(ref_grid)) ||
-      ref_geom_meshlinked(ref_grid_geom(ref_grid))) {
-    RSS(ref_geom_verify_topo(ref_grid), "geom topo");
-    RSS(ref_geom_verify_param(ref_grid), "geom param");
-    ref_mpi_stopwatch_stop(ref_mpi, "geom assoc");
-    RSS(ref_metric_constrain_curvature(ref_grid), "crv const");
-    RSS(ref_validation_cell_volume(ref_grid), "vol");
-    ref_mpi_stopwatch_stop(ref_mpi, "crv const");
-  }
+  RSS(adapt_geom_prepare(ref_grid), "geom prepare");
   RSS(ref_grid_cache_background(ref_grid), "cache");
-  RSS(ref_node_store_aux(ref_grid_node(ref_grid_background(ref_grid)), ldim,
-                         initial_field),
-      "store init field with background");
+  if (lazy_field) {
+    /* field is reread from file onto the background after adaptation */
+    stashed_ldim = ldim;
+  } else if (0 == strcmp(aux_storage, "float")) {
+    stashed_ldim = ldim;
+    RSS(stash_field_float(ref_grid_node(ref_grid_background(ref_grid)), ldim,
+                          initial_field, &aux_float),
+        "store init field as float");
+  } else if (0 == strcmp(aux_storage, "scratch")) {
+    stashed_ldim = ldim;
+    RSS(stash_field_scratch(ref_grid_node(ref_grid_background(ref_grid)), ldim,
+                            initial_field),
+        "store init field in scratch file");
+  } else {
+    RSS(ref_node_store_aux(ref_grid_node(ref_grid_background(ref_grid)), ldim,
+                           initial_field),
+        "store init field with background");
+  }
   ref_free(initial_field);
-  ref_mpi_stopwatch_stop(ref_mpi, "cache background metric and field");
+  RSS(stage_stopwatch_stop(ref_mpi, "cache background metric and field"),
+      "stopwatch");
 
   RSS(ref_migrate_to_balance(ref_grid), "balance");
   RSS(ref_grid_pack(ref_grid), "pack");
-  ref_mpi_stopwatch_stop(ref_mpi, "pack");
+  RSS(stage_stopwatch_stop(ref_mpi, "pack"), "stopwatch");
+
+  RXS(ref_args_find(argc, argv, "--pass-report", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos && pos < argc - 1) {
+    if (ref_mpi_once(ref_mpi)) printf("--pass-report %s\n", argv[pos + 1]);
+    RSS(pass_report_open(ref_mpi, argv[pos + 1]), "open");
+    report_passes = REF_TRUE;
+  }
+
+  RXS(ref_args_find(argc, argv, "--conformity", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos && pos < argc - 1) {
+    conformity = atof(argv[pos + 1]);
+    if (ref_mpi_once(ref_mpi)) printf("--conformity %f\n", conformity);
+  }
 
   for (pass = 0; !all_done && pass < passes; pass++) {
+    RSS(stage_pass_set(pass), "scope");
     if (ref_mpi_once(ref_mpi))
       printf("\n pass %d of %d with %d ranks\n", pass + 1, passes,
              ref_mpi_n(ref_mpi));
+    pass_time = subcommand_wall_time();
     if (form_quads && pass == passes / 2) {
       if (ref_mpi_once(ref_mpi)) printf("form quads\n");
       RSS(ref_layer_align_quad(ref_grid), "quad");
     }
     all_done1 = all_done0;
     RSS(ref_adapt_pass(ref_grid, &all_done0), "pass");
+    pass_seconds[0] = subcommand_wall_time() - pass_time;
+    pass_time = subcommand_wall_time();
     all_done = all_done0 && all_done1 && (pass > MIN(5, passes));
     RSS(ref_metric_synchronize(ref_grid), "sync with background");
-    ref_mpi_stopwatch_stop(ref_mpi, "metric sync");
+    RSS(stage_stopwatch_stop(ref_mpi, "metric sync"), "stopwatch");
+    pass_seconds[1] = subcommand_wall_time() - pass_time;
+    pass_time = subcommand_wall_time();
     RSS(ref_validation_cell_volume(ref_grid), "vol");
     RSS(ref_adapt_tattle_faces(ref_grid), "tattle");
-    ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "tattle faces");
+    RSS(stage_stopwatch_stop(ref_grid_mpi(ref_grid), "tattle faces"),
+        "stopwatch");
     RSS(ref_migrate_to_balance(ref_grid), "balance");
     RSS(ref_grid_pack(ref_grid), "pack");
-    ref_mpi_stopwatch_stop(ref_mpi, "pack");
-  }
+    RSS(stage_stopwatch_stop(ref_mpi, "pack"), "stopwatch");
+    pass_seconds[2] = subcommand_wall_time() - pass_time;
+    if (report_passes)
+      RSS(pass_report_write(ref_grid, pass, pass_seconds), "pass report");
+    if (conformity > 0.0) {
+      RSS(conformity_done(ref_grid, conformity, &last_conformity, &conformed),
+          "conformity");
+      RSS(stage_stopwatch_stop(ref_mpi, "edge conformity"), "stopwatch");
+      /* same guard as the other stop, quads still form at passes / 2 */
+      all_done = all_done || (conformed && (pass > MIN(5, passes)) &&
+                              (!form_quads || pass >= passes / 2));
+    }
+  }
+  RSS(stage_pass_set(REF_EMPTY), "scope");
+  RSS(pass_report_close(), "close pass report");
 
   RXS(ref_args_find(argc, argv, "--usm3d", &pos), REF_NOT_FOUND, "parse usm3d");
   if (REF_EMPTY != pos) {
@@ -3773,10 +5933,10 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
 
   RSS(ref_node_implicit_global_from_local(ref_grid_node(ref_grid)),
       "implicit global");
-  ref_mpi_stopwatch_stop(ref_mpi, "implicit global");
+  RSS(stage_stopwatch_stop(ref_mpi, "implicit global"), "stopwatch");
 
   RSS(ref_geom_verify_param(ref_grid), "final params");
-  ref_mpi_stopwatch_stop(ref_mpi, "verify final params");
+  RSS(stage_stopwatch_stop(ref_mpi, "verify final params"), "stopwatch");
 
   RXS(ref_args_find(argc, argv, "--export-metric", &pos), REF_NOT_FOUND,
       "arg search");
@@ -3784,7 +5944,7 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
     snprintf(filename, 1024, "%s-final-metric.solb", out_project);
     if (ref_mpi_once(ref_mpi)) printf("export metric to %s\n", filename);
     RSS(ref_gather_metric(ref_grid, filename), "export metric");
-    ref_mpi_stopwatch_stop(ref_mpi, "export metric");
+    RSS(stage_stopwatch_stop(ref_mpi, "export metric"), "stopwatch");
   }
 
   snprintf(filename, 1024, "%s.meshb", out_project);
@@ -3792,7 +5952,7 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
     printf("gather " REF_GLOB_FMT " nodes to %s\n",
            ref_node_n_global(ref_grid_node(ref_grid)), filename);
   RSS(ref_gather_by_extension(ref_grid, filename), "gather .meshb");
-  ref_mpi_stopwatch_stop(ref_mpi, "gather meshb");
+  RSS(stage_stopwatch_stop(ref_mpi, "gather meshb"), "stopwatch");
 
   snprintf(filename, 1024, "%s.%s", out_project, mesh_export_extension);
   if (0 != strcmp(soln_export_extension, i_like_restart) &&
@@ -3821,7 +5981,7 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
       RSS(ref_export_by_extension(ref_grid, filename), "export mesh extension");
     }
   }
-  ref_mpi_stopwatch_stop(ref_mpi, "gather mesh extension");
+  RSS(stage_stopwatch_stop(ref_mpi, "gather mesh extension"), "stopwatch");
 
   if (ref_mpi_once(ref_mpi)) {
     printf("%d leading dim from " REF_GLOB_FMT " donor nodes to " REF_GLOB_FMT
@@ -3834,9 +5994,30 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
   if (ref_mpi_once(ref_mpi)) printf("interpolate receptor nodes\n");
   ref_malloc_init(ref_field, ldim * ref_node_max(ref_grid_node(ref_grid)),
                   REF_DBL, 0.0);
-  RSS(ref_node_extract_aux(ref_grid_node(ref_grid_background(ref_grid)), &ldim,
-                           &initial_field),
-      "store init field with background");
+  if (lazy_field) {
+    snprintf(filename, 1024, "%s%s", in_project, soln_import_extension);
+    RSS(reread_initial_field(
+            ref_grid_background(ref_grid), filename, ref_dict_bcs, flip_twod,
+            (REF_EMPTY != deforming_pos && REF_EMPTY == fixed_point_pos),
+            field_adjoint, &ldim, &initial_field),
+        "reread field");
+    REIS(stashed_ldim, ldim, "reread field leading dimension changed");
+  } else if (NULL != aux_float) {
+    ldim = stashed_ldim;
+    RSS(recall_field_float(ref_grid_node(ref_grid_background(ref_grid)), ldim,
+                           aux_float, &initial_field),
+        "recall float field");
+    ref_free(aux_float);
+  } else if (NULL != stash_scratch) {
+    ldim = stashed_ldim;
+    RSS(recall_field_scratch(ref_grid_node(ref_grid_background(ref_grid)), ldim,
+                             &initial_field),
+        "recall scratch field");
+  } else {
+    RSS(ref_node_extract_aux(ref_grid_node(ref_grid_background(ref_grid)),
+                             &ldim, &initial_field),
+        "store init field with background");
+  }
   RSS(ref_validation_finite(ref_grid_background(ref_grid), ldim, initial_field),
       "recall background field");
 
@@ -3850,7 +6031,7 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
       "free cached background grid");
   RSS(ref_interp_free(ref_grid_interp(ref_grid)), "interp free");
   ref_grid_interp(ref_grid) = NULL;
-  ref_mpi_stopwatch_stop(ref_mpi, "interp");
+  RSS(stage_stopwatch_stop(ref_mpi, "interp"), "stopwatch");
 
   if (ref_grid_twod(ref_grid) &&
       0 != strcmp(soln_import_extension, locichem_soln) &&
@@ -3900,7 +6081,7 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
           "gather cell center");
     }
   }
-  ref_mpi_stopwatch_stop(ref_mpi, "gather receptor");
+  RSS(stage_stopwatch_stop(ref_mpi, "gather receptor"), "stopwatch");
 
   ref_free(ref_field);
 
@@ -3940,7 +6121,7 @@ static REF_STATUS hessian_multiscale(REF_MPI ref_mpi, REF_GRID ref_grid,
                                      REF_DBL complexity) {
   if (ref_mpi_once(ref_mpi)) printf("part hessian %s\n", in_scalar);
   RSS(ref_part_metric(ref_grid_node(ref_grid), in_scalar), "part scalar");
-  ref_mpi_stopwatch_stop(ref_mpi, "part metric");
+  RSS(stage_stopwatch_stop(ref_mpi, "part metric"), "stopwatch");
   RSS(ref_metric_from_node(metric, ref_grid_node(ref_grid)), "get node");
   RSS(ref_recon_abs_value_hessian(ref_grid, metric), "abs val");
   RSS(ref_recon_roundoff_limit(metric, ref_grid),
@@ -3949,7 +6130,8 @@ static REF_STATUS hessian_multiscale(REF_MPI ref_mpi, REF_GRID ref_grid,
   RSS(ref_metric_gradation_at_complexity(metric, ref_grid, gradation,
                                          complexity),
       "gradation at complexity");
-  ref_mpi_stopwatch_stop(ref_mpi, "compute metric from hessian");
+  RSS(stage_stopwatch_stop(ref_mpi, "compute metric from hessian"),
+      "stopwatch");
   return REF_SUCCESS;
 }
 
@@ -3961,6 +6143,7 @@ static REF_STATUS multiscale(REF_MPI ref_mpi, int argc, char *argv[]) {
   REF_INT ldim;
   REF_DBL *scalar = NULL;
   REF_DBL *metric = NULL;
+  REF_DBL *hess = NULL;
   REF_INT p;
   REF_DBL gradation, complexity, current_complexity;
   REF_RECON_RECONSTRUCTION reconstruction = REF_RECON_L2PROJECTION;
@@ -3968,6 +6151,7 @@ static REF_STATUS multiscale(REF_MPI ref_mpi, int argc, char *argv[]) {
   REF_INT hessian_pos, fixed_point_pos;
   REF_DBL aspect_ratio = -1.0;
   REF_DICT ref_dict_bcs = NULL;
+  REF_BOOL report_error = REF_TRUE;
 
   if (argc < 6) goto shutdown;
   in_mesh = argv[2];
@@ -4016,6 +6200,12 @@ static REF_STATUS multiscale(REF_MPI ref_mpi, int argc, char *argv[]) {
     aspect_ratio = atof(argv[pos + 1]);
   }
 
+  RXS(ref_args_find(argc, argv, "--no-error-report", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    report_error = REF_FALSE;
+  }
+
   RSS(ref_dict_create(&ref_dict_bcs), "make dict");
   RXS(ref_args_find(argc, argv, "--fun3d-mapbc", &pos), REF_NOT_FOUND,
       "arg search");
@@ -4052,16 +6242,16 @@ static REF_STATUS multiscale(REF_MPI ref_mpi, int argc, char *argv[]) {
   }
   RAS(complexity > 1.0e-20, "complexity must be greater than zero");
 
-  ref_mpi_stopwatch_start(ref_mpi);
+  RSS(stage_stopwatch_start(ref_mpi), "stopwatch");
 
   if (ref_mpi_para(ref_mpi)) {
     if (ref_mpi_once(ref_mpi)) printf("part %s\n", in_mesh);
     RSS(ref_part_by_extension(&ref_grid, ref_mpi, in_mesh), "part");
-    ref_mpi_stopwatch_stop(ref_mpi, "part");
+    RSS(stage_stopwatch_stop(ref_mpi, "part"), "stopwatch");
   } else {
     if (ref_mpi_once(ref_mpi)) printf("import %s\n", in_mesh);
     RSS(ref_import_by_extension(&ref_grid, ref_mpi, in_mesh), "import");
-    ref_mpi_stopwatch_stop(ref_mpi, "import");
+    RSS(stage_stopwatch_stop(ref_mpi, "import"), "stopwatch");
   }
   if (ref_mpi_once(ref_mpi))
     printf("  read " REF_GLOB_FMT " vertices\n",
@@ -4105,16 +6295,22 @@ static REF_STATUS multiscale(REF_MPI ref_mpi, int argc, char *argv[]) {
     if (ref_mpi_once(ref_mpi)) printf("part scalar %s\n", in_scalar);
     RSS(ref_part_scalar(ref_grid, &ldim, &scalar, in_scalar), "part scalar");
     REIS(1, ldim, "expected one scalar");
-    ref_mpi_stopwatch_stop(ref_mpi, "part scalar");
+    RSS(stage_stopwatch_stop(ref_mpi, "part scalar"), "stopwatch");
     
     if (ref_mpi_once(ref_mpi)) printf("reconstruct Hessian, compute metric\n");
-    RSS(ref_metric_lp(metric, ref_grid, scalar, reconstruction, p, gradation,
-                      aspect_ratio, complexity),
+    if (report_error)
+      ref_malloc(hess, 6 * ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
+    RSS(ref_subcommand_multiscale_metric(metric, hess, ref_grid, scalar,
+                                         reconstruction, p, gradation,
+                                         aspect_ratio, complexity),
         "lp norm");
-    ref_mpi_stopwatch_stop(ref_mpi, "compute metric");
-    RSS(ref_subcommand_report_error(metric, ref_grid, scalar, reconstruction,
-                                    complexity),
-        "report error");
+    RSS(stage_stopwatch_stop(ref_mpi, "compute metric"), "stopwatch");
+    if (report_error) {
+      RSS(ref_subcommand_report_error(metric, ref_grid, hess, complexity),
+          "report error");
+      RSS(stage_stopwatch_stop(ref_mpi, "error estimate"), "stopwatch");
+    }
+    ref_free(hess);
     ref_free(scalar);
   }
 
@@ -4123,7 +6319,7 @@ static REF_STATUS multiscale(REF_MPI ref_mpi, int argc, char *argv[]) {
     if (ref_mpi_once(ref_mpi)) printf("buffer at complexity %e\n", complexity);
     RSS(ref_metric_buffer_at_complexity(metric, ref_grid, complexity),
         "buffer at complexity");
-    ref_mpi_stopwatch_stop(ref_mpi, "buffer");
+    RSS(stage_stopwatch_stop(ref_mpi, "buffer"), "stopwatch");
   }
 
   RXS(ref_args_find(argc, argv, "--uniform", &pos), REF_NOT_FOUND,
@@ -4143,7 +6339,7 @@ static REF_STATUS multiscale(REF_MPI ref_mpi, int argc, char *argv[]) {
     const char *title[] = {"spacing", "decay"};
     ref_malloc(hh, 2 * ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
     RSS(ref_metric_isotropic(metric, ref_grid, hh), "iso");
-    ref_mpi_stopwatch_stop(ref_mpi, "isotropic");
+    RSS(stage_stopwatch_stop(ref_mpi, "isotropic"), "stopwatch");
     if (ref_mpi_once(ref_mpi)) printf("gather %s\n", argv[pos + 1]);
     RSS(ref_gather_scalar_by_extension(ref_grid, 2, hh, title, argv[pos + 1]),
         "dump hh");
@@ -4154,7 +6350,7 @@ static REF_STATUS multiscale(REF_MPI ref_mpi, int argc, char *argv[]) {
 
   if (ref_mpi_once(ref_mpi)) printf("gather %s\n", out_metric);
   RSS(ref_gather_metric(ref_grid, out_metric), "gather metric");
-  ref_mpi_stopwatch_stop(ref_mpi, "gather metric");
+  RSS(stage_stopwatch_stop(ref_mpi, "gather metric"), "stopwatch");
 
   RSS(ref_dict_free(ref_dict_bcs), "free");
   RSS(ref_grid_free(ref_grid), "free grid");
@@ -4195,6 +6391,250 @@ shutdown:
   return REF_FAILURE;
 }
 
+static REF_STATUS pipeline_adapt(REF_GRID ref_grid, REF_INT passes,
+                                 REF_INT ldim, REF_DBL **field) {
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_DBL *adapted_field;
+  REF_INT pass;
+  REF_BOOL all_done = REF_FALSE;
+  REF_BOOL all_done0 = REF_FALSE;
+  REF_BOOL all_done1 = REF_FALSE;
+
+  RSS(adapt_geom_prepare(ref_grid), "geom prepare");
+  RSS(ref_grid_cache_background(ref_grid), "cache");
+  RSS(stage_stopwatch_stop(ref_mpi, "cache background metric"), "stopwatch");
+  RSS(ref_migrate_to_balance(ref_grid), "balance");
+  RSS(ref_grid_pack(ref_grid), "pack");
+  RSS(stage_stopwatch_stop(ref_mpi, "pack"), "stopwatch");
+  for (pass = 0; !all_done && pass < passes; pass++) {
+    RSS(stage_pass_set(pass), "scope");
+    if (ref_mpi_once(ref_mpi))
+      printf("\n pass %d of %d with %d ranks\n", pass + 1, passes,
+             ref_mpi_n(ref_mpi));
+    all_done1 = all_done0;
+    RSS(ref_adapt_pass(ref_grid, &all_done0), "pass");
+    all_done = all_done0 && all_done1 && (pass > MIN(5, passes));
+    RSS(ref_metric_synchronize(ref_grid), "sync with background");
+    RSS(stage_stopwatch_stop(ref_mpi, "metric sync"), "stopwatch");
+    RSS(ref_validation_cell_volume(ref_grid), "vol");
+    RSS(ref_migrate_to_balance(ref_grid), "balance");
+    RSS(ref_grid_pack(ref_grid), "pack");
+    RSS(stage_stopwatch_stop(ref_mpi, "pack"), "stopwatch");
+  }
+  RSS(stage_pass_set(REF_EMPTY), "scope");
+  RSS(ref_node_implicit_global_from_local(ref_grid_node(ref_grid)),
+      "implicit global");
+  RSS(stage_stopwatch_stop(ref_mpi, "implicit global"), "stopwatch");
+
+  RSS(ref_geom_verify_param(ref_grid), "final params");
+  RSS(stage_stopwatch_stop(ref_mpi, "verify final params"), "stopwatch");
+
+  if (NULL != *field) {
+    ref_malloc(adapted_field, ldim * ref_node_max(ref_grid_node(ref_grid)),
+               REF_DBL);
+    RSS(ref_interp_scalar(ref_grid_interp(ref_grid), ldim, *field,
+                          adapted_field),
+        "interp scalar");
+    ref_free(*field);
+    *field = adapted_field;
+    RSS(stage_stopwatch_stop(ref_mpi, "interp"), "stopwatch");
+  }
+  RSS(ref_grid_free(ref_grid_background(ref_grid)),
+      "free cached background grid");
+  ref_grid_background(ref_grid) = NULL;
+  RSS(ref_interp_free(ref_grid_interp(ref_grid)), "interp free");
+  ref_grid_interp(ref_grid) = NULL;
+  return REF_SUCCESS;
+}
+
+static REF_STATUS pipeline(REF_MPI ref_mpi, int argc, char *argv[]) {
+  FILE *script;
+  char *text, *next, *end;
+  char line[2048], command[64], arg1[1024], arg2[1024], scope[64];
+  size_t length;
+  long script_size;
+  REF_INT nargs, lineno = 0;
+  REF_GRID ref_grid = NULL;
+  REF_DICT ref_dict_bcs = NULL;
+  REF_DBL *distance = NULL, *field = NULL, *saved_metric = NULL;
+  REF_DBL *metric, *scalar;
+  REF_INT ldim = 0, node, i;
+
+  if (argc < 3) goto shutdown;
+
+  script = fopen(argv[2], "r");
+  if (NULL == (void *)script) {
+    if (ref_mpi_once(ref_mpi)) printf("unable to open %s\n", argv[2]);
+    goto shutdown;
+  }
+  /* read the whole script so command failures do not leave it open */
+  RAB(0 == fseek(script, 0, SEEK_END), "seek script", { fclose(script); });
+  script_size = ftell(script);
+  RAB(0 <= script_size, "size script", { fclose(script); });
+  rewind(script);
+  text = (char *)malloc((size_t)script_size + 1);
+  RAB(NULL != text, "malloc script failed", { fclose(script); });
+  length = fread(text, sizeof(char), (size_t)script_size, script);
+  fclose(script);
+  text[length] = '\0';
+  RSS(ref_dict_create(&ref_dict_bcs), "create");
+
+  next = text;
+  while ('\0' != *next) {
+    end = strchr(next, '\n');
+    length = (NULL == end) ? strlen(next) : (size_t)(end - next);
+    snprintf(line, 2048, "%.*s", (int)MIN(length, 2047), next);
+    next += length + ((NULL == end) ? 0 : 1);
+    lineno++;
+    nargs = sscanf(line, "%63s %1023s %1023s", command, arg1, arg2);
+    if (nargs < 1 || '#' == command[0]) continue;
+    if (ref_mpi_once(ref_mpi))
+      printf("\npipeline line %d: %s\n", lineno, line);
+    snprintf(scope, 64, "line %d %s", lineno, command);
+    RSS(stage_scope_set(scope), "scope");
+    if (0 != strcmp(command, "read") && 0 != strcmp(command, "mapbc") &&
+        0 != strcmp(command, "viscous-tags"))
+      RNS(ref_grid, "pipeline needs read <mesh> before this command");
+    if (0 != strcmp(command, "intersect") &&
+        0 != strcmp(command, "save-metric") &&
+        0 != strcmp(command, "adapt") && 0 != strcmp(command, "distance"))
+      RAS(nargs >= 2, "pipeline command is missing a filename or value");
+
+    if (0 == strcmp(command, "read")) {
+      RAS(NULL == ref_grid, "pipeline reads one mesh");
+      if (ref_mpi_para(ref_mpi)) {
+        RSS(ref_part_by_extension(&ref_grid, ref_mpi, arg1), "part");
+      } else {
+        RSS(ref_import_by_extension(&ref_grid, ref_mpi, arg1), "import");
+      }
+      ref_mpi = ref_grid_mpi(ref_grid); /* ref_grid made a deep copy */
+      RSS(stage_stopwatch_stop(ref_mpi, "read"), "stopwatch");
+      if (ref_mpi_once(ref_mpi))
+        printf("  read " REF_GLOB_FMT " vertices\n",
+               ref_node_n_global(ref_grid_node(ref_grid)));
+    } else if (0 == strcmp(command, "egads")) {
+      RSS(ref_egads_load(ref_grid_geom(ref_grid), arg1), "load egads");
+      RSS(stage_stopwatch_stop(ref_mpi, "load egads"), "stopwatch");
+    } else if (0 == strcmp(command, "mapbc")) {
+      if (ref_mpi_once(ref_mpi)) {
+        RSS(ref_phys_read_mapbc(ref_dict_bcs, arg1),
+            "unable to read fun3d formatted mapbc");
+      }
+      RSS(ref_dict_bcast(ref_dict_bcs, ref_mpi), "bcast");
+    } else if (0 == strcmp(command, "viscous-tags")) {
+      if (ref_mpi_once(ref_mpi)) {
+        RSS(ref_phys_parse_tags(ref_dict_bcs, arg1),
+            "unable to parse viscous tags");
+      }
+      RSS(ref_dict_bcast(ref_dict_bcs, ref_mpi), "bcast");
+    } else if (0 == strcmp(command, "distance")) {
+      RAS(0 < ref_dict_n(ref_dict_bcs), "distance needs mapbc or tags");
+      ref_free(distance);
+      ref_malloc_init(distance, ref_node_max(ref_grid_node(ref_grid)),
+                      REF_DBL, -1.0);
+      RSS(ref_phys_wall_distance(ref_grid, ref_dict_bcs, distance), "dist");
+      RSS(stage_stopwatch_stop(ref_mpi, "wall distance"), "stopwatch");
+    } else if (0 == strcmp(command, "field")) {
+      ref_free(field);
+      RSS(ref_part_scalar(ref_grid, &ldim, &field, arg1), "part scalar");
+      RSS(stage_stopwatch_stop(ref_mpi, "part scalar"), "stopwatch");
+    } else if (0 == strcmp(command, "metric")) {
+      RSS(ref_part_metric(ref_grid_node(ref_grid), arg1), "part metric");
+      RSS(stage_stopwatch_stop(ref_mpi, "part metric"), "stopwatch");
+    } else if (0 == strcmp(command, "multiscale")) {
+      REF_INT index = (nargs > 2) ? atoi(arg2) : 0;
+      RNS(field, "multiscale needs field <solb> first");
+      RAS(0 <= index && index < ldim, "multiscale field index out of range");
+      ref_malloc(scalar, ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
+      ref_malloc(metric, 6 * ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
+      each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
+        scalar[node] = field[index + ldim * node];
+      }
+      RSS(ref_metric_lp(metric, ref_grid, scalar, REF_RECON_L2PROJECTION, 2,
+                        -1.0, -1.0, atof(arg1)),
+          "lp norm");
+      RSS(ref_metric_to_node(metric, ref_grid_node(ref_grid)), "node metric");
+      ref_free(metric);
+      ref_free(scalar);
+      RSS(stage_stopwatch_stop(ref_mpi, "multiscale metric"), "stopwatch");
+    } else if (0 == strcmp(command, "save-metric")) {
+      ref_free(saved_metric);
+      ref_malloc(saved_metric, 6 * ref_node_max(ref_grid_node(ref_grid)),
+                 REF_DBL);
+      RSS(ref_metric_from_node(saved_metric, ref_grid_node(ref_grid)),
+          "get node");
+    } else if (0 == strcmp(command, "intersect")) {
+      REF_DBL m[6];
+      RNS(saved_metric, "intersect needs save-metric first");
+      ref_malloc(metric, 6 * ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
+      RSS(ref_metric_from_node(metric, ref_grid_node(ref_grid)), "get node");
+      each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
+        RSS(ref_matrix_intersect(&(saved_metric[6 * node]),
+                                 &(metric[6 * node]), m),
+            "intersect");
+        for (i = 0; i < 6; i++) metric[i + 6 * node] = m[i];
+      }
+      RSS(ref_metric_to_node(metric, ref_grid_node(ref_grid)), "node metric");
+      ref_free(metric);
+      RSS(stage_stopwatch_stop(ref_mpi, "intersect"), "stopwatch");
+    } else if (0 == strcmp(command, "adapt")) {
+      /* node-indexed arrays other than the field are stale after adapt */
+      ref_free(distance);
+      distance = NULL;
+      ref_free(saved_metric);
+      saved_metric = NULL;
+      if (!ref_geom_model_loaded(ref_grid_geom(ref_grid))) {
+        if (0 < ref_geom_cad_data_size(ref_grid_geom(ref_grid))) {
+          if (ref_mpi_once(ref_mpi))
+            printf("load egadslite from .meshb byte stream\n");
+          RSS(ref_egads_load(ref_grid_geom(ref_grid), NULL), "load egads");
+          RSS(stage_stopwatch_stop(ref_mpi, "load egadslite cad data"),
+              "stopwatch");
+        } else {
+          if (ref_mpi_once(ref_mpi))
+            printf("warning: no geometry loaded, assuming planar faces.\n");
+        }
+      }
+      RSS(pipeline_adapt(ref_grid, (nargs > 1) ? atoi(arg1) : 30, ldim,
+                         &field),
+          "adapt");
+    } else if (0 == strcmp(command, "write-mesh")) {
+      RSS(ref_gather_by_extension(ref_grid, arg1), "gather mesh");
+      RSS(stage_stopwatch_stop(ref_mpi, "gather mesh"), "stopwatch");
+    } else if (0 == strcmp(command, "write-field")) {
+      RNS(field, "write-field needs field <solb> first");
+      RSS(ref_gather_scalar_by_extension(ref_grid, ldim, field, NULL, arg1),
+          "gather field");
+      RSS(stage_stopwatch_stop(ref_mpi, "gather field"), "stopwatch");
+    } else if (0 == strcmp(command, "write-metric")) {
+      RSS(ref_gather_metric(ref_grid, arg1), "gather metric");
+      RSS(stage_stopwatch_stop(ref_mpi, "gather metric"), "stopwatch");
+    } else if (0 == strcmp(command, "write-distance")) {
+      RNS(distance, "write-distance needs distance first");
+      RSS(ref_gather_scalar_by_extension(ref_grid, 1, distance, NULL, arg1),
+          "gather distance");
+      RSS(stage_stopwatch_stop(ref_mpi, "gather distance"), "stopwatch");
+    } else {
+      if (ref_mpi_once(ref_mpi))
+        printf("unknown pipeline command %s on line %d\n", command, lineno);
+      RSS(REF_INVALID, "unknown pipeline command");
+    }
+  }
+  free(text);
+  RSS(stage_scope_set(NULL), "scope");
+
+  ref_free(saved_metric);
+  ref_free(field);
+  ref_free(distance);
+  RSS(ref_dict_free(ref_dict_bcs), "free");
+  if (NULL != ref_grid) RSS(ref_grid_free(ref_grid), "free");
+
+  return REF_SUCCESS;
+shutdown:
+  if (ref_mpi_once(ref_mpi)) pipeline_help(argv[0]);
+  return REF_FAILURE;
+}
+
 static REF_STATUS quilt(REF_MPI ref_mpi, int argc, char *argv[]) {
   REF_GEOM ref_geom;
   char *input_egads;
@@ -4263,6 +6703,265 @@ shutdown:
   return REF_FAILURE;
 }
 
+#ifdef REF_SERVE_SOCKET
+static REF_STATUS serve_probe(REF_GRID ref_grid, REF_INT ldim, REF_DBL *field,
+                              const char *args, FILE *out) {
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_GRID probe_grid;
+  REF_INTERP ref_interp;
+  REF_DBL xyz[3], *probe_field;
+  REF_INT node, i, length;
+  REF_GLOB global = 0;
+
+  RNS(field, "probe needs field <solb> first");
+  RSS(ref_grid_create(&probe_grid, ref_mpi), "create probes");
+  while (3 == sscanf(args, "%lf %lf %lf%n", &(xyz[0]), &(xyz[1]), &(xyz[2]),
+                     &length)) {
+    args += length;
+    RSB(ref_node_add(ref_grid_node(probe_grid), global, &node), "add probe",
+        { ref_grid_free(probe_grid); });
+    for (i = 0; i < 3; i++)
+      ref_node_xyz(ref_grid_node(probe_grid), i, node) = xyz[i];
+    global++;
+  }
+  RSB(ref_node_initialize_n_global(ref_grid_node(probe_grid), global),
+      "init probes", { ref_grid_free(probe_grid); });
+  RAB(0 < global, "probe needs at least one x y z",
+      { ref_grid_free(probe_grid); });
+
+  ref_malloc(probe_field, ldim * ref_node_max(ref_grid_node(probe_grid)),
+             REF_DBL);
+  RSB(ref_interp_create(&ref_interp, ref_grid, probe_grid), "make interp", {
+    ref_free(probe_field);
+    ref_grid_free(probe_grid);
+  });
+  RSB(ref_interp_locate(ref_interp), "locate probes", {
+    ref_interp_free(ref_interp);
+    ref_free(probe_field);
+    ref_grid_free(probe_grid);
+  });
+  RSB(ref_interp_scalar(ref_interp, ldim, field, probe_field), "interp", {
+    ref_interp_free(ref_interp);
+    ref_free(probe_field);
+    ref_grid_free(probe_grid);
+  });
+  each_ref_node_valid_node(ref_grid_node(probe_grid), node) {
+    for (i = 0; i < ldim; i++) {
+      fprintf(out, "%s%.16e", (0 == i ? "" : " "),
+              probe_field[i + ldim * node]);
+    }
+    fprintf(out, "\n");
+  }
+  RSS(ref_interp_free(ref_interp), "interp free");
+  ref_free(probe_field);
+  RSS(ref_grid_free(probe_grid), "free probes");
+  return REF_SUCCESS;
+}
+
+static REF_STATUS serve_intersect(REF_GRID ref_grid, const char *metric0,
+                                  const char *metric1, const char *out_file) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_DBL *metric, *other, m[6];
+  REF_INT node, i;
+
+  ref_malloc(metric, 6 * ref_node_max(ref_node), REF_DBL);
+  ref_malloc(other, 6 * ref_node_max(ref_node), REF_DBL);
+  RSB(ref_part_metric(ref_node, metric0), "part metric", {
+    ref_free(other);
+    ref_free(metric);
+  });
+  RSB(ref_metric_from_node(metric, ref_node), "get node", {
+    ref_free(other);
+    ref_free(metric);
+  });
+  RSB(ref_part_metric(ref_node, metric1), "part metric", {
+    ref_free(other);
+    ref_free(metric);
+  });
+  RSB(ref_metric_from_node(other, ref_node), "get node", {
+    ref_free(other);
+    ref_free(metric);
+  });
+  each_ref_node_valid_node(ref_node, node) {
+    RSB(ref_matrix_intersect(&(metric[6 * node]), &(other[6 * node]), m),
+        "intersect", {
+          ref_free(other);
+          ref_free(metric);
+        });
+    for (i = 0; i < 6; i++) metric[i + 6 * node] = m[i];
+  }
+  RSB(ref_metric_to_node(metric, ref_node), "set node", {
+    ref_free(other);
+    ref_free(metric);
+  });
+  ref_free(other);
+  ref_free(metric);
+  RSS(ref_gather_metric(ref_grid, out_file), "gather metric");
+  return REF_SUCCESS;
+}
+
+static REF_STATUS serve_slice(REF_GRID ref_grid, REF_INT ldim, REF_DBL *field,
+                              const char *args) {
+  REF_DBL normal[3], offset;
+  REF_DBL *out = NULL;
+  REF_GRID slice_grid;
+  char out_slice[1024];
+
+  RNS(field, "slice needs field <solb> first");
+  RAS(5 == sscanf(args, "%lf %lf %lf %lf %1023s", &(normal[0]), &(normal[1]),
+                  &(normal[2]), &offset, out_slice),
+      "slice needs nx ny nz offset and an output");
+  RSS(ref_iso_slice(&slice_grid, ref_grid, normal, offset, ldim, field, &out),
+      "slice");
+  RSB(ref_gather_scalar_by_extension(slice_grid, ldim, out, NULL, out_slice),
+      "gather slice", {
+        ref_free(out);
+        ref_grid_free(slice_grid);
+      });
+  ref_free(out);
+  RSS(ref_grid_free(slice_grid), "free slice");
+  return REF_SUCCESS;
+}
+
+/* answers one request line, payload lines are followed by ok or error */
+static REF_STATUS serve_request(REF_GRID ref_grid, REF_INT *ldim,
+                                REF_DBL **field, char *line, FILE *out,
+                                REF_BOOL *stop) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  char command[64], arg0[1024], arg1[1024], arg2[1024];
+  const char *args;
+  REF_INT nargs, local, length;
+  REF_GLOB global;
+
+  nargs = sscanf(line, "%63s%n", command, &length);
+  if (nargs < 1) return REF_SUCCESS;
+  args = line + length;
+  nargs = sscanf(args, "%1023s %1023s %1023s", arg0, arg1, arg2);
+
+  if (0 == strcmp(command, "shutdown")) {
+    *stop = REF_TRUE;
+  } else if (0 == strcmp(command, "stats")) {
+    fprintf(out, "nodes " REF_GLOB_FMT " tets %d tris %d\n",
+            ref_node_n_global(ref_node), ref_cell_n(ref_grid_tet(ref_grid)),
+            ref_cell_n(ref_grid_tri(ref_grid)));
+  } else if (0 == strcmp(command, "node")) {
+    while (1 == sscanf(args, REF_GLOB_FMT "%n", &global, &length)) {
+      args += length;
+      RSS(ref_node_local(ref_node, global, &local),
+          "global node_index not found");
+      fprintf(out, REF_GLOB_FMT " %.16e %.16e %.16e\n", global,
+              ref_node_xyz(ref_node, 0, local),
+              ref_node_xyz(ref_node, 1, local),
+              ref_node_xyz(ref_node, 2, local));
+    }
+  } else if (0 == strcmp(command, "field")) {
+    RAS(1 <= nargs, "field needs a solb");
+    ref_free(*field);
+    *field = NULL;
+    RSS(ref_part_scalar(ref_grid, ldim, field, arg0), "part scalar");
+    fprintf(out, "ldim %d\n", *ldim);
+  } else if (0 == strcmp(command, "probe")) {
+    RSS(serve_probe(ref_grid, *ldim, *field, args, out), "probe");
+  } else if (0 == strcmp(command, "intersect")) {
+    RAS(3 <= nargs, "intersect needs two metrics and an output");
+    RSS(serve_intersect(ref_grid, arg0, arg1, arg2), "intersect");
+  } else if (0 == strcmp(command, "slice")) {
+    RSS(serve_slice(ref_grid, *ldim, *field, args), "slice");
+  } else if (0 == strcmp(command, "write")) {
+    RAS(1 <= nargs, "write needs a filename");
+    if (NULL == *field) {
+      RSS(ref_gather_by_extension(ref_grid, arg0), "gather mesh");
+    } else {
+      RSS(ref_gather_scalar_by_extension(ref_grid, *ldim, *field, NULL, arg0),
+          "gather field");
+    }
+  } else {
+    RSS(REF_INVALID, "unknown serve request");
+  }
+  return REF_SUCCESS;
+}
+#endif
+
+static REF_STATUS serve(REF_MPI ref_mpi, int argc, char *argv[]) {
+#ifdef REF_SERVE_SOCKET
+  char *in_file, *socket_path;
+  REF_GRID ref_grid = NULL;
+  REF_INT ldim = 0;
+  REF_DBL *field = NULL;
+  struct sockaddr_un address;
+  int listener, connection;
+  FILE *in, *out;
+  char line[4096];
+  REF_BOOL stop = REF_FALSE;
+  REF_STATUS status;
+
+  if (ref_mpi_para(ref_mpi)) {
+    RSS(REF_IMPLEMENT, "ref serve is not parallel");
+  }
+  if (argc < 4) goto shutdown;
+  in_file = argv[2];
+  socket_path = argv[3];
+  RAS(strlen(socket_path) < sizeof(address.sun_path), "socket path too long");
+
+  printf("import %s\n", in_file);
+  RSS(ref_import_by_extension(&ref_grid, ref_mpi, in_file), "import");
+  RSS(stage_stopwatch_stop(ref_mpi, "import"), "stopwatch");
+
+  listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  RAS(0 <= listener, "unable to create socket");
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, socket_path);
+  unlink(socket_path);
+  REIS(0, bind(listener, (struct sockaddr *)&address, sizeof(address)),
+       "unable to bind socket");
+  REIS(0, listen(listener, 8), "unable to listen on socket");
+  printf("serving %s on %s\n", in_file, socket_path);
+  /* a client closing mid reply is a write error, not a fatal signal */
+  signal(SIGPIPE, SIG_IGN);
+
+  while (!stop) {
+    connection = accept(listener, NULL, NULL);
+    if (connection < 0) continue;
+    in = fdopen(connection, "r");
+    out = fdopen(dup(connection), "w");
+    if (NULL == (void *)in || NULL == (void *)out) {
+      if (NULL != (void *)in) fclose(in);
+      if (NULL != (void *)out) fclose(out);
+      close(connection);
+      continue;
+    }
+    while (!stop && NULL != fgets(line, 4096, in)) {
+      if (0 == strncmp(line, "quit", 4)) break;
+      status = serve_request(ref_grid, &ldim, &field, line, out, &stop);
+      if (REF_SUCCESS == status) {
+        fprintf(out, "ok\n");
+      } else {
+        fprintf(out, "error %d\n", status);
+      }
+      if (0 != fflush(out) || ferror(out)) break;
+    }
+    fclose(out);
+    fclose(in);
+  }
+  close(listener);
+  unlink(socket_path);
+
+  ref_free(field);
+  RSS(ref_grid_free(ref_grid), "free");
+
+  return REF_SUCCESS;
+shutdown:
+  if (ref_mpi_once(ref_mpi)) serve_help(argv[0]);
+  return REF_FAILURE;
+#else
+  SUPRESS_UNUSED_COMPILER_WARNING(argc);
+  SUPRESS_UNUSED_COMPILER_WARNING(argv);
+  if (ref_mpi_once(ref_mpi)) printf("serve requires Unix domain sockets\n");
+  return REF_IMPLEMENT;
+#endif
+}
+
 static REF_STATUS translate(REF_MPI ref_mpi, int argc, char *argv[]) {
   char *out_file;
   char *in_file;
@@ -4276,16 +6975,16 @@ static REF_STATUS translate(REF_MPI ref_mpi, int argc, char *argv[]) {
   in_file = argv[2];
   out_file = argv[3];
 
-  ref_mpi_stopwatch_start(ref_mpi);
+  RSS(stage_stopwatch_start(ref_mpi), "stopwatch");
 
   if (ref_mpi_para(ref_mpi)) {
     if (ref_mpi_once(ref_mpi)) printf("part %s\n", in_file);
     RSS(ref_part_by_extension(&ref_grid, ref_mpi, in_file), "part");
-    ref_mpi_stopwatch_stop(ref_mpi, "part");
+    RSS(stage_stopwatch_stop(ref_mpi, "part"), "stopwatch");
   } else {
     if (ref_mpi_once(ref_mpi)) printf("import %s\n", in_file);
     RSS(ref_import_by_extension(&ref_grid, ref_mpi, in_file), "import");
-    ref_mpi_stopwatch_stop(ref_mpi, "import");
+    RSS(stage_stopwatch_stop(ref_mpi, "import"), "stopwatch");
   }
   if (ref_mpi_once(ref_mpi))
     printf("  read " REF_GLOB_FMT " vertices\n",
@@ -4499,7 +7198,7 @@ static REF_STATUS translate(REF_MPI ref_mpi, int argc, char *argv[]) {
                ref_node_n_global(ref_grid_node(ref_grid)), out_file);
     }
     RSS(ref_gather_by_extension(ref_grid, out_file), "gather");
-    ref_mpi_stopwatch_stop(ref_mpi, "gather");
+    RSS(stage_stopwatch_stop(ref_mpi, "gather"), "stopwatch");
   } else {
     if (surface_only) {
       if (ref_mpi_once(ref_mpi)) printf("export surface to %s\n", out_file);
@@ -4509,7 +7208,7 @@ static REF_STATUS translate(REF_MPI ref_mpi, int argc, char *argv[]) {
                ref_node_n_global(ref_grid_node(ref_grid)), out_file);
     }
     RSS(ref_export_by_extension(ref_grid, out_file), "export");
-    ref_mpi_stopwatch_stop(ref_mpi, "export");
+    RSS(stage_stopwatch_stop(ref_mpi, "export"), "stopwatch");
   }
 
   RSS(ref_grid_free(ref_grid), "free grid");
@@ -4535,16 +7234,16 @@ static REF_STATUS visualize(REF_MPI ref_mpi, int argc, char *argv[]) {
   in_sol = argv[3];
   out_sol = argv[4];
 
-  ref_mpi_stopwatch_start(ref_mpi);
+  RSS(stage_stopwatch_start(ref_mpi), "stopwatch");
 
   if (ref_mpi_para(ref_mpi)) {
     if (ref_mpi_once(ref_mpi)) printf("part %s\n", in_mesh);
     RSS(ref_part_by_extension(&ref_grid, ref_mpi, in_mesh), "part");
-    ref_mpi_stopwatch_stop(ref_mpi, "part");
+    RSS(stage_stopwatch_stop(ref_mpi, "part"), "stopwatch");
   } else {
     if (ref_mpi_once(ref_mpi)) printf("import %s\n", in_mesh);
     RSS(ref_import_by_extension(&ref_grid, ref_mpi, in_mesh), "import");
-    ref_mpi_stopwatch_stop(ref_mpi, "import");
+    RSS(stage_stopwatch_stop(ref_mpi, "import"), "stopwatch");
   }
   if (ref_mpi_once(ref_mpi))
     printf("  read " REF_GLOB_FMT " vertices\n",
@@ -4583,7 +7282,7 @@ static REF_STATUS visualize(REF_MPI ref_mpi, int argc, char *argv[]) {
     if (ref_mpi_once(ref_mpi)) printf("imply metric from mesh\n");
     ref_malloc(metric, 6 * ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
     RSS(ref_metric_imply_from(metric, ref_grid), "imply");
-    ref_mpi_stopwatch_stop(ref_mpi, "metric implied");
+    RSS(stage_stopwatch_stop(ref_mpi, "metric implied"), "stopwatch");
     hmin = REF_DBL_MAX;
     each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
       RSS(ref_matrix_diag_m(&(metric[6 * node]), diag), "decomp");
@@ -4608,7 +7307,7 @@ static REF_STATUS visualize(REF_MPI ref_mpi, int argc, char *argv[]) {
     if (ref_mpi_once(ref_mpi)) printf("read solution %s\n", in_sol);
     RSS(ref_part_scalar(ref_grid, &ldim, &field, in_sol), "scalar");
     if (ref_mpi_once(ref_mpi)) printf("  with leading dimension %d\n", ldim);
-    ref_mpi_stopwatch_stop(ref_mpi, "read solution");
+    RSS(stage_stopwatch_stop(ref_mpi, "read solution"), "stopwatch");
   }
 
   RXS(ref_args_find(argc, argv, "--boom", &pos), REF_NOT_FOUND, "arg search");
@@ -4643,7 +7342,7 @@ static REF_STATUS visualize(REF_MPI ref_mpi, int argc, char *argv[]) {
       if (ref_mpi_once(ref_mpi)) printf("   phi %f h %f\n", phi, h);
       RSS(ref_iso_boom_zone(file, ref_grid, dp_pinf, 1, center, aoa, phi, h),
           " boom zone");
-      ref_mpi_stopwatch_stop(ref_mpi, "export ray");
+      RSS(stage_stopwatch_stop(ref_mpi, "export ray"), "stopwatch");
     }
     ref_free(dp_pinf);
     ref_free(field);
@@ -4704,7 +7403,7 @@ static REF_STATUS visualize(REF_MPI ref_mpi, int argc, char *argv[]) {
     in_diff = argv[pos + 1];
     if (ref_mpi_once(ref_mpi)) printf("read diff solution %s\n", in_diff);
     RSS(ref_part_scalar(ref_grid, &diff_ldim, &diff_field, in_diff), "diff");
-    ref_mpi_stopwatch_stop(ref_mpi, "read diff solution");
+    RSS(stage_stopwatch_stop(ref_mpi, "read diff solution"), "stopwatch");
     REIS(ldim, diff_ldim, "difference field must have same leading dimension");
     each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
       for (i = 0; i < ldim; i++) {
@@ -4712,7 +7411,8 @@ static REF_STATUS visualize(REF_MPI ref_mpi, int argc, char *argv[]) {
       }
     }
     ref_free(diff_field);
-    ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "diff field");
+    RSS(stage_stopwatch_stop(ref_grid_mpi(ref_grid), "diff field"),
+        "stopwatch");
     for (i = 0; i < ldim; i++) {
       REF_DBL max_diff = 0.0;
       REF_DBL total_diff = 0.0;
@@ -4825,12 +7525,13 @@ static REF_STATUS visualize(REF_MPI ref_mpi, int argc, char *argv[]) {
       }
       RSS(ref_iso_insert(&iso_grid, ref_grid, scalar, ldim, field, &out),
           "iso");
-      ref_mpi_stopwatch_stop(ref_mpi, "insert iso");
+      RSS(stage_stopwatch_stop(ref_mpi, "insert iso"), "stopwatch");
       if (ref_mpi_once(ref_mpi))
         printf("write isosurface %d ldim %s\n", ldim, out_iso);
       RSS(ref_gather_scalar_by_extension(iso_grid, ldim, out, NULL, out_iso),
           "gather");
-      ref_mpi_stopwatch_stop(ref_mpi, "write isosurface geometry");
+      RSS(stage_stopwatch_stop(ref_mpi, "write isosurface geometry"),
+          "stopwatch");
 
       ref_free(out);
       ref_grid_free(iso_grid);
@@ -4857,13 +7558,13 @@ static REF_STATUS visualize(REF_MPI ref_mpi, int argc, char *argv[]) {
       RSS(ref_iso_slice(&slice_grid, ref_grid, normal, offset, ldim, field,
                         &out),
           "slice");
-      ref_mpi_stopwatch_stop(ref_mpi, "insert slice");
+      RSS(stage_stopwatch_stop(ref_mpi, "insert slice"), "stopwatch");
       if (ref_mpi_once(ref_mpi))
         printf("write slice %d ldim %s\n", ldim, out_slice);
       RSS(ref_gather_scalar_by_extension(slice_grid, ldim, out, NULL,
                                          out_slice),
           "gather");
-      ref_mpi_stopwatch_stop(ref_mpi, "write slice");
+      RSS(stage_stopwatch_stop(ref_mpi, "write slice"), "stopwatch");
       ref_free(out);
       ref_grid_free(slice_grid);
     }
@@ -4899,7 +7600,7 @@ static REF_STATUS visualize(REF_MPI ref_mpi, int argc, char *argv[]) {
     }
     RSS(ref_gather_scalar_by_extension(ref_grid, ldim, field, NULL, out_sol),
         "gather");
-    ref_mpi_stopwatch_stop(ref_mpi, "write solution");
+    RSS(stage_stopwatch_stop(ref_mpi, "write solution"), "stopwatch");
   }
   ref_free(field);
   RSS(ref_grid_free(ref_grid), "free grid");
@@ -4924,7 +7625,7 @@ int main(int argc, char *argv[]) {
 
   RSS(ref_mpi_start(argc, argv), "start");
   RSS(ref_mpi_create(&ref_mpi), "make mpi");
-  ref_mpi_stopwatch_start(ref_mpi);
+  RSS(stage_stopwatch_start(ref_mpi), "stopwatch");
 
   if (ref_mpi_once(ref_mpi)) {
     printf("refine %s on %d ranks\n", VERSION, ref_mpi_n(ref_mpi));
@@ -4957,13 +7658,55 @@ int main(int argc, char *argv[]) {
     if (ref_mpi_once(ref_mpi)) printf("--timing %d\n", ref_mpi_timing(ref_mpi));
   }
 
+  RXS(ref_args_find(argc, argv, "--perf-counters", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    if (ref_mpi_once(ref_mpi)) printf("--perf-counters\n");
+    RSS(stage_perf_open(ref_mpi), "perf counters");
+  }
+
+  RXS(ref_args_find(argc, argv, "--stage-report", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos && pos < argc - 1) {
+    if (ref_mpi_once(ref_mpi)) printf("--stage-report %s\n", argv[pos + 1]);
+    RSS(stage_report_open(ref_mpi, argv[pos + 1], argv[1]), "stage report");
+  }
+
+  RXS(ref_args_find(argc, argv, "--trace", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos && pos < argc - 1) {
+    if (ref_mpi_once(ref_mpi)) printf("--trace %s\n", argv[pos + 1]);
+    stage_subcommand = argv[1];
+    RSS(stage_trace_open(ref_mpi, argv[pos + 1]), "trace");
+  }
+
+  RXS(ref_args_find(argc, argv, "--threads", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos && pos < argc - 1) {
+#ifdef _OPENMP
+    if (atoi(argv[pos + 1]) > 0) omp_set_num_threads(atoi(argv[pos + 1]));
+    if (ref_mpi_once(ref_mpi))
+      printf("--threads %d per rank\n", omp_get_max_threads());
+#else
+    if (ref_mpi_once(ref_mpi))
+      printf("--threads ignored, not compiled with OpenMP\n");
+#endif
+  }
+
   if (strncmp(argv[1], "a", 1) == 0) {
     if (REF_EMPTY == help_pos) {
-      RSS(adapt(ref_mpi, argc, argv), "adapt");
+      RSB(adapt(ref_mpi, argc, argv), "adapt", { pass_report_close(); });
     } else {
       if (ref_mpi_once(ref_mpi)) adapt_help(argv[0]);
       goto shutdown;
     }
+  } else if (strncmp(argv[1], "be", 2) == 0) {
+    if (REF_EMPTY == help_pos) {
+      RSS(bench(ref_mpi, argc, argv), "bench");
+    } else {
+      if (ref_mpi_once(ref_mpi)) bench_help(argv[0]);
+      goto shutdown;
+    }
   } else if (strncmp(argv[1], "b", 1) == 0) {
     if (REF_EMPTY == help_pos) {
       RSS(bootstrap(ref_mpi, argc, argv), "bootstrap");
@@ -4992,6 +7735,13 @@ int main(int argc, char *argv[]) {
       if (ref_mpi_once(ref_mpi)) examine_help(argv[0]);
       goto shutdown;
     }
+  } else if (strncmp(argv[1], "f", 1) == 0) {
+    if (REF_EMPTY == help_pos) {
+      RSS(fixture(ref_mpi, argc, argv), "fixture");
+    } else {
+      if (ref_mpi_once(ref_mpi)) fixture_help(argv[0]);
+      goto shutdown;
+    }
   } else if (strncmp(argv[1], "g", 1) == 0) {
     if (REF_EMPTY == help_pos) {
       RSS(grow(ref_mpi, argc, argv), "grow");
@@ -5009,6 +7759,8 @@ int main(int argc, char *argv[]) {
   } else if (strncmp(argv[1], "l", 1) == 0) {
     if (REF_EMPTY == help_pos) {
       RSB(loop(ref_mpi, argc, argv), "loop", {
+        stash_scratch_close();
+        pass_report_close();
         if (ref_mpi_once(ref_mpi)) loop_help(argv[0]);
       });
     } else {
@@ -5029,6 +7781,13 @@ int main(int argc, char *argv[]) {
       if (ref_mpi_once(ref_mpi)) node_help(argv[0]);
       goto shutdown;
     }
+  } else if (strncmp(argv[1], "p", 1) == 0) {
+    if (REF_EMPTY == help_pos) {
+      RSS(pipeline(ref_mpi, argc, argv), "pipeline");
+    } else {
+      if (ref_mpi_once(ref_mpi)) pipeline_help(argv[0]);
+      goto shutdown;
+    }
   } else if (strncmp(argv[1], "q", 1) == 0) {
     if (REF_EMPTY == help_pos) {
       RSS(quilt(ref_mpi, argc, argv), "quilt");
@@ -5036,6 +7795,13 @@ int main(int argc, char *argv[]) {
       if (ref_mpi_once(ref_mpi)) quilt_help(argv[0]);
       goto shutdown;
     }
+  } else if (strncmp(argv[1], "se", 2) == 0) {
+    if (REF_EMPTY == help_pos) {
+      RSS(serve(ref_mpi, argc, argv), "serve");
+    } else {
+      if (ref_mpi_once(ref_mpi)) serve_help(argv[0]);
+      goto shutdown;
+    }
   } else if (strncmp(argv[1], "s", 1) == 0) {
     if (ref_mpi_once(ref_mpi))
       printf("  surface      depreciated, use translate ... --surface.\n");
@@ -5066,8 +7832,11 @@ int main(int argc, char *argv[]) {
     goto shutdown;
   }
 
-  ref_mpi_stopwatch_stop(ref_mpi, "done.");
+  RSS(stage_stopwatch_stop(ref_mpi, "done."), "stopwatch");
 shutdown:
+  RSS(stage_report_close(), "stage report");
+  RSS(stage_trace_close(), "trace");
+  RSS(stage_perf_close(), "perf counters");
   RSS(ref_mpi_free(ref_mpi), "mpi free");
   RSS(ref_mpi_stop(), "stop");
 